@@ -0,0 +1,700 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "audio.h"
+
+#define FRAME_BYTES (ENG_AUDIO_CHANNELS * (int)sizeof(float))
+#define MIX_CHUNK_FRAMES 512
+#define MUSIC_READ_BYTES 4096
+#define MUSIC_MIN_SPACE 1024
+#define LONG_SOUND_SECONDS 10
+
+#define WAV_RIFF 0x46464952
+#define WAV_WAVE 0x45564157
+#define WAV_FMT 0x20746d66
+#define WAV_DATA 0x61746164
+
+typedef enum {
+	COMMAND_PLAY,
+	COMMAND_STOP,
+	COMMAND_STOP_ALL,
+	COMMAND_VOLUME,
+	COMMAND_MASTER_VOLUME,
+	COMMAND_MUSIC_VOLUME,
+} CommandType;
+
+typedef struct {
+	CommandType type;
+	eng_Voice voice;
+	eng_Sound *sound;
+	float volume;
+	float pan;
+	bool loop;
+	uint64_t queuedNS;
+} Command;
+
+typedef struct {
+	eng_Voice id;
+	eng_Sound *sound;
+	uint32_t position;
+	float volume;
+	float pan;
+	float left;
+	float right;
+	bool loop;
+} Voice;
+
+typedef struct {
+	uint64_t mixNS;
+	uint64_t maxMixNS;
+	uint64_t latencyNS;
+	uint64_t maxLatencyNS;
+	uint64_t commandCount;
+	uint64_t callbacks;
+	uint64_t framesMixed;
+	uint32_t underruns;
+	uint32_t activeVoices;
+	uint32_t droppedVoices;
+} MixerStats;
+
+static const SDL_AudioSpec mixSpec = {
+	.format = SDL_AUDIO_F32,
+	.channels = ENG_AUDIO_CHANNELS,
+	.freq = ENG_AUDIO_RATE,
+};
+
+static SDL_AudioStream *audioStream = NULL;
+
+// Single producer single consumer queue, the game thread writes commands and the audio callback reads them
+static Command commands[ENG_AUDIO_COMMANDS];
+static SDL_AtomicU32 commandWrite;
+static SDL_AtomicU32 commandRead;
+static SDL_AtomicInt droppedCommands;
+static eng_Voice nextVoice = 1;
+
+// Everything below is only touched by the audio callback, or by other threads while holding the stream lock
+static Voice voices[ENG_AUDIO_VOICES];
+static float mixBuffer[MIX_CHUNK_FRAMES * ENG_AUDIO_CHANNELS];
+static float masterVolume = 1.0f;
+static float musicVolume = 1.0f;
+static bool musicActive = false;
+static MixerStats mixerStats;
+
+// Decoded music, the music thread writes frames and the callback reads them
+static float musicRing[ENG_MUSIC_BUFFER_FRAMES * ENG_AUDIO_CHANNELS];
+static SDL_AtomicU32 musicWrite;
+static SDL_AtomicU32 musicRead;
+static SDL_AtomicInt musicRunning;
+static SDL_AtomicInt musicFinished;
+static SDL_Thread *musicThread = NULL;
+
+typedef struct {
+	SDL_IOStream *file;
+	SDL_AudioStream *converter;
+	int64_t dataStart;
+	uint32_t dataSize;
+	uint32_t dataLeft;
+	bool loop;
+} MusicSource;
+
+static MusicSource music;
+
+static eng_Sound **sounds = NULL;
+static uint32_t soundCount = 0;
+static uint32_t soundCapacity = 0;
+
+static void setVoiceGain(Voice *voice) {
+	voice->left = voice->volume * SDL_min(1.0f, 1.0f - voice->pan);
+	voice->right = voice->volume * SDL_min(1.0f, 1.0f + voice->pan);
+}
+
+static void startVoice(Command *command) {
+	Voice *voice = NULL;
+	for (uint32_t i = 0; i < ENG_AUDIO_VOICES; i++) {
+		if (voices[i].sound == NULL) {
+			voice = &voices[i];
+			break;
+		}
+	}
+
+	if (voice == NULL) {
+		mixerStats.droppedVoices++;
+		return;
+	}
+
+	*voice = (Voice) {
+		.id = command->voice,
+		.sound = command->sound,
+		.position = 0,
+		.volume = command->volume,
+		.pan = command->pan,
+		.loop = command->loop,
+	};
+	setVoiceGain(voice);
+}
+
+static Voice *findVoice(eng_Voice id) {
+	for (uint32_t i = 0; i < ENG_AUDIO_VOICES; i++) {
+		if (voices[i].sound != NULL && voices[i].id == id) {
+			return &voices[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void readCommands(uint64_t now) {
+	uint32_t read = SDL_GetAtomicU32(&commandRead);
+	uint32_t write = SDL_GetAtomicU32(&commandWrite);
+
+	for (; read != write; read++) {
+		Command *command = &commands[read & (ENG_AUDIO_COMMANDS - 1)];
+		Voice *voice;
+
+		switch (command->type) {
+			case COMMAND_PLAY:
+				startVoice(command);
+				break;
+			case COMMAND_STOP:
+				voice = findVoice(command->voice);
+				if (voice != NULL) {
+					voice->sound = NULL;
+				}
+				break;
+			case COMMAND_STOP_ALL:
+				for (uint32_t i = 0; i < ENG_AUDIO_VOICES; i++) {
+					voices[i].sound = NULL;
+				}
+				break;
+			case COMMAND_VOLUME:
+				voice = findVoice(command->voice);
+				if (voice != NULL) {
+					voice->volume = command->volume;
+					setVoiceGain(voice);
+				}
+				break;
+			case COMMAND_MASTER_VOLUME:
+				masterVolume = command->volume;
+				break;
+			case COMMAND_MUSIC_VOLUME:
+				musicVolume = command->volume;
+				break;
+		}
+
+		uint64_t latency = now > command->queuedNS ? now - command->queuedNS : 0;
+		mixerStats.latencyNS += latency;
+		mixerStats.maxLatencyNS = SDL_max(mixerStats.maxLatencyNS, latency);
+		mixerStats.commandCount++;
+	}
+
+	SDL_SetAtomicU32(&commandRead, read);
+}
+
+static void mixVoice(Voice *voice, uint32_t frames) {
+	uint32_t written = 0;
+
+	while (written < frames) {
+		uint32_t count = SDL_min(voice->sound->frames - voice->position, frames - written);
+		const float *source = &voice->sound->samples[voice->position * ENG_AUDIO_CHANNELS];
+		float *destination = &mixBuffer[written * ENG_AUDIO_CHANNELS];
+
+		for (uint32_t i = 0; i < count; i++) {
+			destination[i * 2] += source[i * 2] * voice->left;
+			destination[i * 2 + 1] += source[i * 2 + 1] * voice->right;
+		}
+		voice->position += count;
+		written += count;
+
+		if (voice->position == voice->sound->frames) {
+			if (!voice->loop) {
+				voice->sound = NULL;
+				return;
+			}
+			voice->position = 0;
+		}
+	}
+}
+
+static void mixMusic(uint32_t frames) {
+	uint32_t read = SDL_GetAtomicU32(&musicRead);
+	uint32_t available = SDL_GetAtomicU32(&musicWrite) - read;
+	uint32_t count = SDL_min(available, frames);
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t index = ((read + i) & (ENG_MUSIC_BUFFER_FRAMES - 1)) * ENG_AUDIO_CHANNELS;
+		mixBuffer[i * 2] += musicRing[index] * musicVolume;
+		mixBuffer[i * 2 + 1] += musicRing[index + 1] * musicVolume;
+	}
+	SDL_SetAtomicU32(&musicRead, read + count);
+
+	if (count < frames) {
+		if (SDL_GetAtomicInt(&musicFinished)) {
+			musicActive = false;
+		} else {
+			mixerStats.underruns++;
+		}
+	}
+}
+
+static void mixChunk(uint32_t frames) {
+	memset(mixBuffer, 0, frames * FRAME_BYTES);
+
+	uint32_t active = 0;
+	for (uint32_t i = 0; i < ENG_AUDIO_VOICES; i++) {
+		if (voices[i].sound != NULL) {
+			mixVoice(&voices[i], frames);
+			active++;
+		}
+	}
+	mixerStats.activeVoices = active;
+
+	if (musicActive) {
+		mixMusic(frames);
+	}
+
+	for (uint32_t i = 0; i < frames * ENG_AUDIO_CHANNELS; i++) {
+		mixBuffer[i] = SDL_clamp(mixBuffer[i] * masterVolume, -1.0f, 1.0f);
+	}
+}
+
+// Runs on SDL's audio thread with the stream locked, it must never allocate or wait on the game
+static void SDLCALL mixCallback(void *data, SDL_AudioStream *stream, int additionalAmount, int totalAmount) {
+	uint64_t start = SDL_GetTicksNS();
+	readCommands(start);
+
+	uint32_t frames = additionalAmount / FRAME_BYTES;
+	mixerStats.framesMixed += frames;
+	while (frames > 0) {
+		uint32_t chunk = SDL_min(frames, MIX_CHUNK_FRAMES);
+		mixChunk(chunk);
+		SDL_PutAudioStreamData(stream, mixBuffer, chunk * FRAME_BYTES);
+		frames -= chunk;
+	}
+
+	uint64_t mixNS = SDL_GetTicksNS() - start;
+	mixerStats.mixNS += mixNS;
+	mixerStats.maxMixNS = SDL_max(mixerStats.maxMixNS, mixNS);
+	mixerStats.callbacks++;
+}
+
+static bool pushCommand(Command command) {
+	if (audioStream == NULL) {
+		return false;
+	}
+
+	uint32_t write = SDL_GetAtomicU32(&commandWrite);
+	if (write - SDL_GetAtomicU32(&commandRead) == ENG_AUDIO_COMMANDS) {
+		// The callback hasn't run for a while, dropping keeps the game thread from waiting on audio
+		SDL_AddAtomicInt(&droppedCommands, 1);
+		return false;
+	}
+
+	command.queuedNS = SDL_GetTicksNS();
+	commands[write & (ENG_AUDIO_COMMANDS - 1)] = command;
+	SDL_SetAtomicU32(&commandWrite, write + 1);
+
+	return true;
+}
+
+ENG_RESULT eng_initAudio(bool dummy) {
+	if (audioStream != NULL) {
+		return SUCCESS;
+	}
+
+	if (dummy) {
+		SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+	}
+
+	if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+		return eng_setErrorDetail(FAILED_TO_INIT_AUDIO, "Failed to start the audio subsystem");
+	}
+
+	audioStream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &mixSpec, mixCallback, NULL);
+	if (audioStream == NULL) {
+		SDL_QuitSubSystem(SDL_INIT_AUDIO);
+		return eng_setErrorDetail(FAILED_TO_INIT_AUDIO, "Failed to open the playback device");
+	}
+
+	SDL_SetAtomicU32(&commandWrite, 0);
+	SDL_SetAtomicU32(&commandRead, 0);
+	memset(voices, 0, sizeof(voices));
+	eng_resetAudioStats();
+
+	if (!SDL_ResumeAudioStreamDevice(audioStream)) {
+		SDL_DestroyAudioStream(audioStream);
+		audioStream = NULL;
+		SDL_QuitSubSystem(SDL_INIT_AUDIO);
+		return eng_setErrorDetail(FAILED_TO_INIT_AUDIO, "Failed to start the playback device");
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_AUDIO, "Opened audio\tDriver: %s\tBuffer: %.2f ms", SDL_GetCurrentAudioDriver(), eng_getAudioStats().deviceBufferMS);
+
+	return SUCCESS;
+}
+
+eng_Sound *eng_loadSound(const char *path) {
+	if (path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < soundCount; i++) {
+		if (strcmp(sounds[i]->path, path) == 0) {
+			return sounds[i];
+		}
+	}
+
+	if (soundCount == soundCapacity) {
+		uint32_t newCapacity = soundCapacity == 0 ? 16 : soundCapacity * 2;
+		eng_Sound **newSounds = realloc(sounds, newCapacity * sizeof(eng_Sound *));
+		if (newSounds == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			return NULL;
+		}
+		sounds = newSounds;
+		soundCapacity = newCapacity;
+	}
+
+	SDL_AudioSpec spec;
+	Uint8 *data = NULL;
+	Uint32 length = 0;
+	if (!SDL_LoadWAV(path, &spec, &data, &length)) {
+		eng_setErrorDetail(FAILED_TO_LOAD_SOUND, "%s", path);
+		return NULL;
+	}
+
+	Uint8 *converted = NULL;
+	int convertedLength = 0;
+	bool success = SDL_ConvertAudioSamples(&spec, data, (int)length, &mixSpec, &converted, &convertedLength);
+	SDL_free(data);
+	if (!success || convertedLength < FRAME_BYTES) {
+		SDL_free(converted);
+		eng_setErrorDetail(FAILED_TO_LOAD_SOUND, "%s has no samples that could be converted", path);
+		return NULL;
+	}
+
+	eng_Sound *sound = (eng_Sound *)malloc(sizeof(eng_Sound));
+	if (sound == NULL || (sound->path = SDL_strdup(path)) == NULL) {
+		free(sound);
+		SDL_free(converted);
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+	sound->samples = (float *)converted;
+	sound->frames = convertedLength / FRAME_BYTES;
+	sounds[soundCount++] = sound;
+	eng_trackMemory(ENG_MEMORY_SOUNDS, (int64_t)sound->frames * FRAME_BYTES, 1);
+
+	if (sound->frames > LONG_SOUND_SECONDS * ENG_AUDIO_RATE) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_AUDIO, "%s is %u seconds long, eng_playMusic streams it instead of keeping it in memory", path, sound->frames / ENG_AUDIO_RATE);
+	}
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_AUDIO, "Loaded sound %s\tFrames: %u", path, sound->frames);
+
+	return sound;
+}
+
+eng_Voice eng_playSound(eng_Sound *sound, float volume, float pan, bool loop) {
+	if (sound == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_VOICE;
+	}
+
+	eng_Voice voice = nextVoice++;
+	if (nextVoice == ENG_NO_VOICE) {
+		nextVoice = 1;
+	}
+
+	Command command = (Command) {
+		.type = COMMAND_PLAY,
+		.voice = voice,
+		.sound = sound,
+		.volume = SDL_max(volume, 0.0f),
+		.pan = SDL_clamp(pan, -1.0f, 1.0f),
+		.loop = loop,
+	};
+
+	return pushCommand(command) ? voice : ENG_NO_VOICE;
+}
+
+void eng_stopVoice(eng_Voice voice) {
+	pushCommand((Command) {
+		.type = COMMAND_STOP,
+		.voice = voice,
+	});
+}
+
+void eng_setVoiceVolume(eng_Voice voice, float volume) {
+	pushCommand((Command) {
+		.type = COMMAND_VOLUME,
+		.voice = voice,
+		.volume = SDL_max(volume, 0.0f),
+	});
+}
+
+void eng_stopAllSounds() {
+	pushCommand((Command) {
+		.type = COMMAND_STOP_ALL,
+	});
+}
+
+void eng_setMasterVolume(float volume) {
+	pushCommand((Command) {
+		.type = COMMAND_MASTER_VOLUME,
+		.volume = SDL_max(volume, 0.0f),
+	});
+}
+
+void eng_setMusicVolume(float volume) {
+	pushCommand((Command) {
+		.type = COMMAND_MUSIC_VOLUME,
+		.volume = SDL_max(volume, 0.0f),
+	});
+}
+
+static bool readFormat(SDL_IOStream *file, uint32_t size, SDL_AudioSpec *spec) {
+	Uint16 formatTag, channels, blockAlign, bits;
+	Uint32 rate, byteRate;
+	if (size < 16 || !SDL_ReadU16LE(file, &formatTag) || !SDL_ReadU16LE(file, &channels) || !SDL_ReadU32LE(file, &rate)
+		|| !SDL_ReadU32LE(file, &byteRate) || !SDL_ReadU16LE(file, &blockAlign) || !SDL_ReadU16LE(file, &bits)) {
+		return false;
+	}
+
+	if (formatTag == 1 && bits == 16) {
+		spec->format = SDL_AUDIO_S16LE;
+	} else if (formatTag == 1 && bits == 32) {
+		spec->format = SDL_AUDIO_S32LE;
+	} else if (formatTag == 3 && bits == 32) {
+		spec->format = SDL_AUDIO_F32LE;
+	} else {
+		return false;
+	}
+	spec->channels = channels;
+	spec->freq = (int)rate;
+
+	return channels > 0 && rate > 0 && SDL_SeekIO(file, size - 16, SDL_IO_SEEK_CUR) >= 0;
+}
+
+// Finds the format and the sample data in a RIFF WAV file, other chunks are skipped
+static bool openWav(SDL_IOStream *file, SDL_AudioSpec *spec) {
+	Uint32 id, size, type;
+	if (!SDL_ReadU32LE(file, &id) || !SDL_ReadU32LE(file, &size) || !SDL_ReadU32LE(file, &type) || id != WAV_RIFF || type != WAV_WAVE) {
+		return false;
+	}
+
+	bool foundFormat = false;
+	while (SDL_ReadU32LE(file, &id) && SDL_ReadU32LE(file, &size)) {
+		if (id == WAV_FMT) {
+			if (!readFormat(file, size, spec)) {
+				return false;
+			}
+			foundFormat = true;
+		} else if (id == WAV_DATA) {
+			music.dataStart = SDL_TellIO(file);
+			music.dataSize = size;
+			music.dataLeft = size;
+			return foundFormat;
+		} else if (SDL_SeekIO(file, size + (size & 1), SDL_IO_SEEK_CUR) < 0) {
+			return false;
+		}
+	}
+
+	return false;
+}
+
+static int decodeMusic(void *data) {
+	Uint8 readBuffer[MUSIC_READ_BYTES];
+	bool flushed = false;
+
+	while (SDL_GetAtomicInt(&musicRunning)) {
+		uint32_t write = SDL_GetAtomicU32(&musicWrite);
+		uint32_t space = ENG_MUSIC_BUFFER_FRAMES - (write - SDL_GetAtomicU32(&musicRead));
+		if (space < MUSIC_MIN_SPACE) {
+			SDL_Delay(2);
+			continue;
+		}
+
+		// Converted frames are moved into the ring first, the file is only read when the converter runs dry
+		int available = SDL_GetAudioStreamAvailable(music.converter) / FRAME_BYTES;
+		if (available > 0) {
+			uint32_t start = write & (ENG_MUSIC_BUFFER_FRAMES - 1);
+			uint32_t count = SDL_min(SDL_min((uint32_t)available, space), ENG_MUSIC_BUFFER_FRAMES - start);
+			int got = SDL_GetAudioStreamData(music.converter, &musicRing[start * ENG_AUDIO_CHANNELS], count * FRAME_BYTES);
+			if (got > 0) {
+				SDL_SetAtomicU32(&musicWrite, write + got / FRAME_BYTES);
+			}
+			continue;
+		}
+
+		if (music.dataLeft > 0) {
+			size_t length = SDL_ReadIO(music.file, readBuffer, SDL_min(music.dataLeft, MUSIC_READ_BYTES));
+			if (length == 0) {
+				music.dataLeft = 0;
+				continue;
+			}
+			music.dataLeft -= (uint32_t)length;
+			SDL_PutAudioStreamData(music.converter, readBuffer, (int)length);
+		} else if (music.loop) {
+			SDL_SeekIO(music.file, music.dataStart, SDL_IO_SEEK_SET);
+			music.dataLeft = music.dataSize;
+		} else if (!flushed) {
+			SDL_FlushAudioStream(music.converter);
+			flushed = true;
+		} else {
+			SDL_SetAtomicInt(&musicFinished, 1);
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void closeMusic() {
+	if (music.converter != NULL) {
+		SDL_DestroyAudioStream(music.converter);
+	}
+	if (music.file != NULL) {
+		SDL_CloseIO(music.file);
+	}
+	music = (MusicSource) {0};
+}
+
+void eng_stopMusic() {
+	if (musicThread != NULL) {
+		SDL_SetAtomicInt(&musicRunning, 0);
+		SDL_WaitThread(musicThread, NULL);
+		musicThread = NULL;
+	}
+
+	if (audioStream != NULL) {
+		SDL_LockAudioStream(audioStream);
+		musicActive = false;
+		SDL_SetAtomicU32(&musicWrite, 0);
+		SDL_SetAtomicU32(&musicRead, 0);
+		SDL_UnlockAudioStream(audioStream);
+	}
+
+	closeMusic();
+}
+
+ENG_RESULT eng_playMusic(const char *path, bool loop) {
+	if (path == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (audioStream == NULL) {
+		return eng_setErrorDetail(FAILED_TO_INIT_AUDIO, "eng_initAudio wasn't called before playing %s", path);
+	}
+
+	eng_stopMusic();
+
+	music.file = SDL_IOFromFile(path, "rb");
+	if (music.file == NULL) {
+		return eng_setErrorDetail(FAILED_TO_LOAD_SOUND, "%s", path);
+	}
+
+	SDL_AudioSpec spec;
+	if (!openWav(music.file, &spec)) {
+		closeMusic();
+		return eng_setErrorDetail(FAILED_TO_LOAD_SOUND, "%s isn't a 16 bit, 32 bit or float WAV file", path);
+	}
+
+	music.converter = SDL_CreateAudioStream(&spec, &mixSpec);
+	if (music.converter == NULL) {
+		closeMusic();
+		return eng_setErrorDetail(FAILED_TO_LOAD_SOUND, "Can't convert %s from %d Hz with %d channels", path, spec.freq, spec.channels);
+	}
+	music.loop = loop;
+
+	SDL_SetAtomicInt(&musicFinished, 0);
+	SDL_SetAtomicInt(&musicRunning, 1);
+	musicThread = SDL_CreateThread(decodeMusic, "eng_music", NULL);
+	if (musicThread == NULL) {
+		closeMusic();
+		return eng_setError(FAILED_TO_START_THREAD);
+	}
+
+	SDL_LockAudioStream(audioStream);
+	musicActive = true;
+	SDL_UnlockAudioStream(audioStream);
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_AUDIO, "Playing music %s\tRate: %d\tChannels: %d", path, spec.freq, spec.channels);
+
+	return SUCCESS;
+}
+
+eng_AudioStats eng_getAudioStats() {
+	eng_AudioStats stats = {0};
+	if (audioStream == NULL) {
+		return stats;
+	}
+
+	SDL_LockAudioStream(audioStream);
+	MixerStats mixer = mixerStats;
+	SDL_UnlockAudioStream(audioStream);
+
+	if (mixer.callbacks > 0) {
+		stats.averageMixMS = (float)mixer.mixNS / mixer.callbacks / SDL_NS_PER_MS;
+	}
+	if (mixer.framesMixed > 0) {
+		stats.mixLoad = (float)((double)mixer.mixNS / ((double)mixer.framesMixed * SDL_NS_PER_SECOND / ENG_AUDIO_RATE));
+	}
+	if (mixer.commandCount > 0) {
+		stats.averageLatencyMS = (float)mixer.latencyNS / mixer.commandCount / SDL_NS_PER_MS;
+	}
+	stats.maxMixMS = (float)mixer.maxMixNS / SDL_NS_PER_MS;
+	stats.maxLatencyMS = (float)mixer.maxLatencyNS / SDL_NS_PER_MS;
+	stats.callbacks = mixer.callbacks;
+	stats.framesMixed = mixer.framesMixed;
+	stats.underruns = mixer.underruns;
+	stats.activeVoices = mixer.activeVoices;
+	stats.droppedVoices = mixer.droppedVoices;
+	stats.droppedCommands = (uint32_t)SDL_GetAtomicInt(&droppedCommands);
+
+	SDL_AudioSpec spec;
+	int frames = 0;
+	if (SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(audioStream), &spec, &frames) && spec.freq > 0) {
+		stats.deviceBufferMS = (float)frames * 1000.0f / spec.freq;
+	}
+
+	return stats;
+}
+
+void eng_resetAudioStats() {
+	if (audioStream != NULL) {
+		SDL_LockAudioStream(audioStream);
+	}
+	mixerStats = (MixerStats) {0};
+	SDL_SetAtomicInt(&droppedCommands, 0);
+	if (audioStream != NULL) {
+		SDL_UnlockAudioStream(audioStream);
+	}
+}
+
+void eng_quitAudio() {
+	eng_stopMusic();
+
+	if (audioStream != NULL) {
+		// Destroying the stream closes the device so the callback can't run again
+		SDL_DestroyAudioStream(audioStream);
+		audioStream = NULL;
+		SDL_QuitSubSystem(SDL_INIT_AUDIO);
+	}
+
+	for (uint32_t i = 0; i < soundCount; i++) {
+		eng_trackMemory(ENG_MEMORY_SOUNDS, -(int64_t)sounds[i]->frames * FRAME_BYTES, -1);
+		SDL_free(sounds[i]->samples);
+		SDL_free(sounds[i]->path);
+		free(sounds[i]);
+	}
+	free(sounds);
+	sounds = NULL;
+	soundCount = 0;
+	soundCapacity = 0;
+	nextVoice = 1;
+}
@@ -0,0 +1,92 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "engine.h"
+
+/*
+* Sound effects and music mixed on SDL's audio thread.
+*
+* The game thread never touches the mixer, eng_playSound and the other calls write a command into a lock-free queue that the audio callback
+* reads at the start of every mix. The callback mixes a fixed pool of voices into a static buffer so it never allocates or waits on the game.
+*
+* Sound effects are decoded once by eng_loadSound and the samples are kept until eng_quit. Music is decoded on a background thread
+* a little at a time into a ring buffer the callback reads from, so a long track never sits in memory.
+*
+* The command functions should only be called from one thread, normally the game thread.
+*/
+
+#define ENG_AUDIO_RATE 48000
+#define ENG_AUDIO_CHANNELS 2
+#define ENG_AUDIO_VOICES 32
+#define ENG_AUDIO_COMMANDS 256 // Must be a power of two
+#define ENG_MUSIC_BUFFER_FRAMES 16384 // Must be a power of two
+
+typedef uint32_t eng_Voice;
+
+#define ENG_NO_VOICE 0
+
+typedef struct {
+	char *path;
+	float *samples; // Interleaved stereo at ENG_AUDIO_RATE
+	uint32_t frames;
+} eng_Sound;
+
+typedef struct {
+	float averageMixMS; // Time spent in the callback
+	float maxMixMS;
+	float mixLoad; // Time spent mixing divided by the length of the audio mixed
+	float averageLatencyMS; // From a command being queued to the callback reading it
+	float maxLatencyMS;
+	float deviceBufferMS; // Added on top of the latency by the device
+	uint64_t callbacks;
+	uint64_t framesMixed;
+	uint32_t underruns; // Times the music thread didn't decode fast enough
+	uint32_t activeVoices;
+	uint32_t droppedCommands; // Commands thrown away because the queue was full
+	uint32_t droppedVoices; // Sounds that didn't play because every voice was busy
+} eng_AudioStats;
+
+/*
+* Opens the default playback device. With dummy set SDL's dummy driver is used so audio runs the same way without a sound card,
+* useful for headless tests and for measuring the mixer
+*/
+ENG_RESULT eng_initAudio(bool dummy);
+
+/*
+* Decodes a WAV file into the mixer's format, loading the same path again returns the cached sound. Meant for short effects, use eng_playMusic for long tracks
+*/
+eng_Sound *eng_loadSound(const char *path);
+
+/*
+* Starts playing a sound, volume is 0 to 1 and pan is -1 for left to 1 for right. Returns ENG_NO_VOICE if it couldn't be queued
+*/
+eng_Voice eng_playSound(eng_Sound *sound, float volume, float pan, bool loop);
+
+/*
+* Stops a voice, does nothing if it already finished
+*/
+void eng_stopVoice(eng_Voice voice);
+
+void eng_setVoiceVolume(eng_Voice voice, float volume);
+
+void eng_stopAllSounds();
+
+void eng_setMasterVolume(float volume);
+
+/*
+* Streams a WAV file, replacing the music that was playing. 16 and 32 bit integer and 32 bit float files are supported at any rate
+*/
+ENG_RESULT eng_playMusic(const char *path, bool loop);
+
+void eng_stopMusic();
+
+void eng_setMusicVolume(float volume);
+
+/*
+* Returns the mixer's timings and counters since eng_initAudio or the last eng_resetAudioStats
+*/
+eng_AudioStats eng_getAudioStats();
+
+void eng_resetAudioStats();
+
+#endif
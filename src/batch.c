@@ -0,0 +1,383 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "batch.h"
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+static bool reserveRects(eng_RectBatch *batch, uint32_t capacity) {
+	if (capacity <= batch->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&batch->h, capacity, sizeof(float))
+		|| !growArray((void **)&batch->w, capacity, sizeof(float))
+		|| !growArray((void **)&batch->x, capacity, sizeof(float))
+		|| !growArray((void **)&batch->y, capacity, sizeof(float))
+		|| !growArray((void **)&batch->color, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&batch->generation, capacity, sizeof(uint32_t))) {
+		return false;
+	}
+	batch->capacity = capacity;
+
+	return true;
+}
+
+void eng_fillQuadIndices(int *indices, uint32_t from, uint32_t to) {
+	for (uint32_t i = from; i < to; i++) {
+		int vertex = i * 4;
+		int *index = &indices[i * 6];
+		index[0] = vertex;
+		index[1] = vertex + 1;
+		index[2] = vertex + 2;
+		index[3] = vertex;
+		index[4] = vertex + 2;
+		index[5] = vertex + 3;
+	}
+}
+
+// The index pattern never changes, so it's only written when the batch grows past it
+static bool reserveVertices(eng_RectBatch *batch, uint32_t count) {
+	if (count <= batch->indexCapacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&batch->vertices, count * 8, sizeof(float))
+		|| !growArray((void **)&batch->vertexColors, count * 4, sizeof(SDL_FColor))
+		|| !growArray((void **)&batch->indices, count * 6, sizeof(int))) {
+		return false;
+	}
+
+	eng_fillQuadIndices(batch->indices, batch->indexCapacity, count);
+	batch->indexCapacity = count;
+
+	return true;
+}
+
+eng_RectBatch *eng_createRectBatch(uint32_t capacity) {
+	eng_RectBatch *batch = (eng_RectBatch *)calloc(1, sizeof(eng_RectBatch));
+	if (batch == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	if (!reserveRects(batch, capacity == 0 ? 64 : capacity)) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroyRectBatch(batch);
+		return NULL;
+	}
+
+	return batch;
+}
+
+uint32_t eng_rectBatchAdd(eng_RectBatch *batch, float h, float w, float x, float y, uint32_t color) {
+	if (batch->count == batch->capacity && !reserveRects(batch, batch->capacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_BATCH_INVALID;
+	}
+
+	uint32_t index = batch->count++;
+	batch->h[index] = h;
+	batch->w[index] = w;
+	batch->x[index] = x;
+	batch->y[index] = y;
+	batch->color[index] = color;
+	batch->generation[index] = ++batch->nextGeneration;
+
+	return index;
+}
+
+ENG_RESULT eng_rectBatchRemove(eng_RectBatch *batch, uint32_t index) {
+	if (batch == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (index >= batch->count) {
+		return eng_setError(POSITION_HIGHER_THAN_QUEUE_LENGTH);
+	}
+
+	uint32_t last = --batch->count;
+	batch->h[index] = batch->h[last];
+	batch->w[index] = batch->w[last];
+	batch->x[index] = batch->x[last];
+	batch->y[index] = batch->y[last];
+	batch->color[index] = batch->color[last];
+	batch->generation[index] = ++batch->nextGeneration;
+
+	return SUCCESS;
+}
+
+void eng_rectBatchClear(eng_RectBatch *batch) {
+	batch->count = 0;
+}
+
+void eng_renderRectBatch(SDL_Renderer *renderer, eng_RectBatch *batch) {
+	uint32_t count = batch->count;
+	if (count == 0 || !reserveVertices(batch, count)) {
+		return;
+	}
+
+	float *vertex = batch->vertices;
+	for (uint32_t i = 0; i < count; i++) {
+		float left = batch->x[i];
+		float top = batch->y[i];
+		float right = left + batch->w[i];
+		float bottom = top + batch->h[i];
+
+		vertex[0] = left;
+		vertex[1] = top;
+		vertex[2] = right;
+		vertex[3] = top;
+		vertex[4] = right;
+		vertex[5] = bottom;
+		vertex[6] = left;
+		vertex[7] = bottom;
+		vertex += 8;
+	}
+
+	SDL_FColor *vertexColor = batch->vertexColors;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t color = batch->color[i];
+		SDL_FColor unpacked = (SDL_FColor) {
+			.r = (float)(color >> 24) / 255.0f,
+			.g = (float)((color >> 16) & 0xFF) / 255.0f,
+			.b = (float)((color >> 8) & 0xFF) / 255.0f,
+			.a = (float)(color & 0xFF) / 255.0f,
+		};
+
+		vertexColor[0] = unpacked;
+		vertexColor[1] = unpacked;
+		vertexColor[2] = unpacked;
+		vertexColor[3] = unpacked;
+		vertexColor += 4;
+	}
+
+	// Untextured geometry uses the draw blend mode, so it's set here instead of depending on what was drawn before
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	eng_countDrawCalls(1, 1);
+	SDL_RenderGeometryRaw(renderer, NULL, batch->vertices, 2 * sizeof(float), batch->vertexColors, sizeof(SDL_FColor), NULL, 0, count * 4, batch->indices, count * 6, sizeof(int));
+	SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+}
+
+void eng_destroyRectBatch(eng_RectBatch *batch) {
+	if (batch == NULL) {
+		return;
+	}
+
+	free(batch->h);
+	free(batch->w);
+	free(batch->x);
+	free(batch->y);
+	free(batch->color);
+	free(batch->generation);
+	free(batch->vertices);
+	free(batch->vertexColors);
+	free(batch->indices);
+	free(batch);
+}
+
+static bool reserveSprites(eng_SpriteBatch *batch, uint32_t capacity) {
+	if (capacity <= batch->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&batch->x, capacity, sizeof(int16_t))
+		|| !growArray((void **)&batch->y, capacity, sizeof(int16_t))
+		|| !growArray((void **)&batch->sheetX, capacity, sizeof(uint16_t))
+		|| !growArray((void **)&batch->sheetY, capacity, sizeof(uint16_t))) {
+		return false;
+	}
+	batch->capacity = capacity;
+
+	return true;
+}
+
+static bool reserveSpriteVertices(eng_SpriteBatch *batch, uint32_t count) {
+	if (count <= batch->indexCapacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&batch->vertices, count * 8, sizeof(float))
+		|| !growArray((void **)&batch->uvs, count * 8, sizeof(float))
+		|| !growArray((void **)&batch->indices, count * 6, sizeof(int))) {
+		return false;
+	}
+
+	eng_fillQuadIndices(batch->indices, batch->indexCapacity, count);
+	batch->indexCapacity = count;
+
+	return true;
+}
+
+eng_SpriteBatch *eng_createSpriteBatch(Window *window, const char *path, uint16_t spriteW, uint16_t spriteH, uint16_t scale, uint32_t capacity) {
+	if (window == NULL || path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	eng_SpriteBatch *batch = (eng_SpriteBatch *)calloc(1, sizeof(eng_SpriteBatch));
+	if (batch == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	if (!reserveSprites(batch, capacity == 0 ? 64 : capacity)) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroySpriteBatch(batch);
+		return NULL;
+	}
+
+	int sheetW, sheetH;
+	if (window->pRenderer != NULL) {
+		batch->texture = eng_loadTexture(window->pRenderer, path);
+		if (batch->texture == NULL) {
+			eng_destroySpriteBatch(batch);
+			return NULL;
+		}
+		SDL_SetTextureScaleMode(batch->texture, SDL_SCALEMODE_NEAREST);
+		sheetW = batch->texture->w;
+		sheetH = batch->texture->h;
+	} else if (!eng_loadImageSize(path, &sheetW, &sheetH)) {
+		eng_destroySpriteBatch(batch);
+		return NULL;
+	}
+
+	batch->sheetW = sheetW;
+	batch->sheetH = sheetH;
+	batch->spriteW = spriteW == 0 ? batch->sheetW : spriteW;
+	batch->spriteH = spriteH == 0 ? batch->sheetH : spriteH;
+	batch->scale = scale == 0 ? 1 : scale;
+	batch->tint = (SDL_FColor) {
+		.r = 1.0f,
+		.g = 1.0f,
+		.b = 1.0f,
+		.a = 1.0f,
+	};
+
+	return batch;
+}
+
+uint32_t eng_spriteBatchAdd(eng_SpriteBatch *batch, int16_t x, int16_t y, uint16_t column, uint16_t row) {
+	// Done in 32 bits so a column or row far past the sheet can't wrap around into it
+	uint32_t sheetX = (uint32_t)column * batch->spriteW;
+	uint32_t sheetY = (uint32_t)row * batch->spriteH;
+	if (sheetX + batch->spriteW > batch->sheetW || sheetY + batch->spriteH > batch->sheetH) {
+		eng_setErrorDetail(SPRITE_OUTSIDE_SHEET, "Column %u Row %u", column, row);
+		return ENG_BATCH_INVALID;
+	}
+
+	if (batch->count == batch->capacity && !reserveSprites(batch, batch->capacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_BATCH_INVALID;
+	}
+
+	uint32_t index = batch->count++;
+	batch->x[index] = x;
+	batch->y[index] = y;
+	batch->sheetX[index] = sheetX;
+	batch->sheetY[index] = sheetY;
+
+	return index;
+}
+
+ENG_RESULT eng_spriteBatchRemove(eng_SpriteBatch *batch, uint32_t index) {
+	if (batch == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (index >= batch->count) {
+		return eng_setError(POSITION_HIGHER_THAN_QUEUE_LENGTH);
+	}
+
+	uint32_t last = --batch->count;
+	batch->x[index] = batch->x[last];
+	batch->y[index] = batch->y[last];
+	batch->sheetX[index] = batch->sheetX[last];
+	batch->sheetY[index] = batch->sheetY[last];
+
+	return SUCCESS;
+}
+
+void eng_spriteBatchClear(eng_SpriteBatch *batch) {
+	batch->count = 0;
+}
+
+void eng_renderSpriteBatch(SDL_Renderer *renderer, eng_SpriteBatch *batch) {
+	uint32_t count = batch->count;
+	if (count == 0 || !reserveSpriteVertices(batch, count)) {
+		return;
+	}
+
+	float width = batch->spriteW * batch->scale;
+	float height = batch->spriteH * batch->scale;
+	float *vertex = batch->vertices;
+	for (uint32_t i = 0; i < count; i++) {
+		float left = batch->x[i];
+		float top = batch->y[i];
+
+		vertex[0] = left;
+		vertex[1] = top;
+		vertex[2] = left + width;
+		vertex[3] = top;
+		vertex[4] = left + width;
+		vertex[5] = top + height;
+		vertex[6] = left;
+		vertex[7] = top + height;
+		vertex += 8;
+	}
+
+	float u = 1.0f / batch->sheetW;
+	float v = 1.0f / batch->sheetH;
+	float spriteU = batch->spriteW * u;
+	float spriteV = batch->spriteH * v;
+	float *uv = batch->uvs;
+	for (uint32_t i = 0; i < count; i++) {
+		float left = batch->sheetX[i] * u;
+		float top = batch->sheetY[i] * v;
+
+		uv[0] = left;
+		uv[1] = top;
+		uv[2] = left + spriteU;
+		uv[3] = top;
+		uv[4] = left + spriteU;
+		uv[5] = top + spriteV;
+		uv[6] = left;
+		uv[7] = top + spriteV;
+		uv += 8;
+	}
+
+	// A color stride of 0 makes every vertex read the same tint
+	eng_countDrawCalls(1, 1);
+	SDL_RenderGeometryRaw(renderer, batch->texture, batch->vertices, 2 * sizeof(float), &batch->tint, 0, batch->uvs, 2 * sizeof(float), count * 4, batch->indices, count * 6, sizeof(int));
+}
+
+void eng_destroySpriteBatch(eng_SpriteBatch *batch) {
+	if (batch == NULL) {
+		return;
+	}
+
+	eng_destroyTexture(batch->texture);
+	free(batch->x);
+	free(batch->y);
+	free(batch->sheetX);
+	free(batch->sheetY);
+	free(batch->vertices);
+	free(batch->uvs);
+	free(batch->indices);
+	free(batch);
+}
@@ -0,0 +1,116 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "engine.h"
+
+#define ENG_BATCH_INVALID UINT32_MAX
+
+/*
+* A batch of solid rects stored as separate arrays, the whole batch is drawn with a single geometry call.
+*
+* The x, y, w, h and color arrays can be written to directly, color is packed with eng_packColor. Add the batch to a render queue with TYPE_RECT_BATCH.
+*/
+typedef struct {
+	float *h;
+	float *w;
+	float *x;
+	float *y;
+	uint32_t *color;
+	uint32_t count;
+	uint32_t capacity;
+
+	// Changes whenever another rect ends up at the index, transform bindings compare it to notice their rect is gone
+	uint32_t *generation;
+	uint32_t nextGeneration;
+
+	// Used while drawing, these are rebuilt from the arrays above every frame
+	float *vertices;
+	SDL_FColor *vertexColors;
+	int *indices;
+	uint32_t indexCapacity;
+} eng_RectBatch;
+
+/*
+* Creates an empty batch with room for capacity rects, the batch grows by itself if more are added
+*/
+eng_RectBatch *eng_createRectBatch(uint32_t capacity);
+
+/*
+* Adds a rect to the batch and returns its index, ENG_BATCH_INVALID if there was no memory to grow the batch
+*/
+uint32_t eng_rectBatchAdd(eng_RectBatch *batch, float h, float w, float x, float y, uint32_t color);
+
+/*
+* Removes a rect by moving the last rect into its place, so the last index changes to the removed one
+*/
+ENG_RESULT eng_rectBatchRemove(eng_RectBatch *batch, uint32_t index);
+
+/*
+* Removes every rect without freeing any memory
+*/
+void eng_rectBatchClear(eng_RectBatch *batch);
+
+/*
+* Draws every rect in the batch, this is called by the render queue for TYPE_RECT_BATCH
+*/
+void eng_renderRectBatch(SDL_Renderer *renderer, eng_RectBatch *batch);
+
+void eng_destroyRectBatch(eng_RectBatch *batch);
+
+/*
+* A batch of same sized sprites cut from one sprite sheet, drawn with a single geometry call and nearest sampling.
+*
+* Positions and sheet coordinates are stored as 16 bit integers so sprites always land on whole pixels and each sprite only takes 8 bytes.
+* SDL only accepts float vertices so they're expanded once per frame while drawing, every vertex shares the same tint.
+* Add the batch to a render queue with TYPE_SPRITE_BATCH, the batch owns its texture.
+* Without a renderer the texture stays NULL and only the sheet's size is read so simulations keep the batch's geometry.
+*/
+typedef struct {
+	SDL_Texture *texture;
+	int16_t *x;
+	int16_t *y;
+	uint16_t *sheetX;
+	uint16_t *sheetY;
+	uint32_t count;
+	uint32_t capacity;
+
+	uint16_t sheetW;
+	uint16_t sheetH;
+	uint16_t spriteW;
+	uint16_t spriteH;
+	uint16_t scale;
+	SDL_FColor tint;
+
+	// Used while drawing, these are rebuilt from the arrays above every frame
+	float *vertices;
+	float *uvs;
+	int *indices;
+	uint32_t indexCapacity;
+} eng_SpriteBatch;
+
+/*
+* Loads the sprite sheet at path, every sprite is spriteW by spriteH pixels in the sheet and is drawn scale times bigger
+*/
+eng_SpriteBatch *eng_createSpriteBatch(Window *window, const char *path, uint16_t spriteW, uint16_t spriteH, uint16_t scale, uint32_t capacity);
+
+/*
+* Adds the sprite at column and row of the sheet at x and y, returns its index or ENG_BATCH_INVALID if the sprite isn't fully inside
+* the sheet or there was no memory to grow the batch
+*/
+uint32_t eng_spriteBatchAdd(eng_SpriteBatch *batch, int16_t x, int16_t y, uint16_t column, uint16_t row);
+
+/*
+* Removes a sprite by moving the last sprite into its place, so the last index changes to the removed one
+*/
+ENG_RESULT eng_spriteBatchRemove(eng_SpriteBatch *batch, uint32_t index);
+
+void eng_spriteBatchClear(eng_SpriteBatch *batch);
+
+/*
+* Draws every sprite in the batch, this is called by the render queue for TYPE_SPRITE_BATCH
+*/
+void eng_renderSpriteBatch(SDL_Renderer *renderer, eng_SpriteBatch *batch);
+
+void eng_destroySpriteBatch(eng_SpriteBatch *batch);
+
+#endif
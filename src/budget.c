@@ -0,0 +1,500 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "budget.h"
+
+#define NO_TEXTURE UINT32_MAX
+
+typedef struct {
+	char *path;
+	SDL_Renderer *renderer;
+	SDL_Texture *texture;
+	uint64_t bytes;
+	uint32_t references;
+	uint64_t lastUsed;
+	bool stale; // The file was reloaded, the texture is freed once nothing uses it
+	bool orphaned; // The renderer was destroyed while it was used, only the references are left to count down
+} CachedTexture;
+
+typedef struct {
+	char *path;
+	uint32_t size;
+	TTF_Font *font;
+	uint64_t bytes;
+	uint32_t references;
+	bool stale; // The file was reloaded, the font is closed once nothing uses it
+} CachedFont;
+
+static eng_MemoryStats memory;
+static bool overBudget[ENG_MEMORY_CATEGORY_COUNT];
+
+static CachedTexture *textures = NULL;
+static uint32_t textureCount = 0;
+static uint32_t textureCapacity = 0;
+static uint64_t useClock = 0;
+
+static CachedFont *fonts = NULL;
+static uint32_t fontCount = 0;
+static uint32_t fontCapacity = 0;
+
+const char *eng_getMemoryCategoryName(ENG_MEMORY_CATEGORY category) {
+	switch (category) {
+		case ENG_MEMORY_TEXTURES:
+			return "textures";
+		case ENG_MEMORY_FONTS:
+			return "fonts";
+		case ENG_MEMORY_QUEUE:
+			return "queue nodes";
+		case ENG_MEMORY_POOLS:
+			return "pools";
+		case ENG_MEMORY_SOUNDS:
+			return "sounds";
+		default:
+			return "unknown";
+	}
+}
+
+void eng_trackMemory(ENG_MEMORY_CATEGORY category, int64_t bytes, int32_t count) {
+	eng_MemoryUsage *usage = &memory.categories[category];
+
+	// Clamped so a free that was never counted can't wrap the totals around
+	uint64_t before = usage->bytes;
+	usage->bytes = bytes < 0 && (uint64_t)-bytes > usage->bytes ? 0 : usage->bytes + bytes;
+	usage->count = count < 0 && (uint32_t)-count > usage->count ? 0 : usage->count + count;
+	usage->peakBytes = SDL_max(usage->peakBytes, usage->bytes);
+	usage->peakCount = SDL_max(usage->peakCount, usage->count);
+
+	memory.totalBytes = memory.totalBytes - before + usage->bytes;
+	memory.peakTotalBytes = SDL_max(memory.peakTotalBytes, memory.totalBytes);
+
+	// Textures warn after eviction had a chance to bring them back under
+	if (category == ENG_MEMORY_TEXTURES || usage->budget == 0) {
+		return;
+	}
+
+	if (usage->bytes > usage->budget && !overBudget[category]) {
+		overBudget[category] = true;
+		eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "Over the %s budget\tUsed: %llu\tBudget: %llu", eng_getMemoryCategoryName(category),
+			(unsigned long long)usage->bytes, (unsigned long long)usage->budget);
+	} else if (usage->bytes <= usage->budget) {
+		overBudget[category] = false;
+	}
+}
+
+static uint64_t getTextureBytes(SDL_Texture *texture) {
+	return (uint64_t)texture->w * texture->h * 4;
+}
+
+SDL_Texture *eng_createTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface) {
+	SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+	eng_addTextureMemory(texture);
+
+	return texture;
+}
+
+void eng_addTextureMemory(SDL_Texture *texture) {
+	if (texture == NULL) {
+		return;
+	}
+
+	eng_trackMemory(ENG_MEMORY_TEXTURES, (int64_t)getTextureBytes(texture), 1);
+}
+
+void eng_destroyTexture(SDL_Texture *texture) {
+	if (texture == NULL) {
+		return;
+	}
+
+	eng_trackMemory(ENG_MEMORY_TEXTURES, -(int64_t)getTextureBytes(texture), -1);
+	SDL_DestroyTexture(texture);
+}
+
+static void removeTexture(uint32_t index) {
+	CachedTexture *cached = &textures[index];
+	if (cached->references == 0) {
+		memory.unusedTextures--;
+		memory.unusedTextureBytes -= cached->bytes;
+	}
+
+	if (!cached->orphaned) {
+		eng_destroyTexture(cached->texture);
+	}
+	SDL_free(cached->path);
+	textures[index] = textures[--textureCount];
+}
+
+// Frees the least recently used textures nothing is using until the budget is met
+static void evictTextures() {
+	eng_MemoryUsage *usage = &memory.categories[ENG_MEMORY_TEXTURES];
+	if (usage->budget == 0) {
+		return;
+	}
+
+	while (usage->bytes > usage->budget) {
+		uint32_t oldest = NO_TEXTURE;
+		for (uint32_t i = 0; i < textureCount; i++) {
+			if (textures[i].references == 0 && (oldest == NO_TEXTURE || textures[i].lastUsed < textures[oldest].lastUsed)) {
+				oldest = i;
+			}
+		}
+
+		if (oldest == NO_TEXTURE) {
+			break;
+		}
+
+		eng_log(ENG_LOG_TRACE, ENG_LOG_ASSET, "Evicted %s\tBytes: %llu", textures[oldest].path, (unsigned long long)textures[oldest].bytes);
+		removeTexture(oldest);
+		memory.evictions++;
+	}
+
+	if (usage->bytes > usage->budget && !overBudget[ENG_MEMORY_TEXTURES]) {
+		overBudget[ENG_MEMORY_TEXTURES] = true;
+		eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "Over the texture budget with every texture in use\tUsed: %llu\tBudget: %llu",
+			(unsigned long long)usage->bytes, (unsigned long long)usage->budget);
+	} else if (usage->bytes <= usage->budget) {
+		overBudget[ENG_MEMORY_TEXTURES] = false;
+	}
+}
+
+static SDL_Texture *findTexture(SDL_Renderer *renderer, const char *path) {
+	for (uint32_t i = 0; i < textureCount; i++) {
+		CachedTexture *cached = &textures[i];
+		if (!cached->stale && cached->renderer == renderer && strcmp(cached->path, path) == 0) {
+			if (cached->references++ == 0) {
+				memory.unusedTextures--;
+				memory.unusedTextureBytes -= cached->bytes;
+			}
+			cached->lastUsed = ++useClock;
+			memory.textureHits++;
+			return cached->texture;
+		}
+	}
+
+	return NULL;
+}
+
+static bool reserveTexture() {
+	if (textureCount < textureCapacity) {
+		return true;
+	}
+
+	uint32_t newCapacity = textureCapacity == 0 ? 64 : textureCapacity * 2;
+	CachedTexture *newTextures = realloc(textures, newCapacity * sizeof(CachedTexture));
+	if (newTextures == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return false;
+	}
+	textures = newTextures;
+	textureCapacity = newCapacity;
+
+	return true;
+}
+
+// Takes ownership of path, which has to come from SDL_strdup
+static void addTexture(SDL_Renderer *renderer, char *path, SDL_Texture *texture) {
+	textures[textureCount++] = (CachedTexture) {
+		.path = path,
+		.renderer = renderer,
+		.texture = texture,
+		.bytes = getTextureBytes(texture),
+		.references = 1,
+		.lastUsed = ++useClock,
+	};
+	evictTextures();
+}
+
+SDL_Texture *eng_acquireTexture(SDL_Renderer *renderer, const char *path) {
+	SDL_Texture *texture = findTexture(renderer, path);
+	if (texture != NULL) {
+		return texture;
+	}
+
+	if (!reserveTexture()) {
+		return NULL;
+	}
+
+	char *copy = SDL_strdup(path);
+	if (copy == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	texture = eng_loadTexture(renderer, path);
+	if (texture == NULL) {
+		SDL_free(copy);
+		return NULL;
+	}
+	addTexture(renderer, copy, texture);
+
+	return texture;
+}
+
+SDL_Texture *eng_acquireTextureFromSurface(SDL_Renderer *renderer, const char *path, SDL_Surface *surface) {
+	SDL_Texture *texture = findTexture(renderer, path);
+	if (texture != NULL) {
+		return texture;
+	}
+
+	if (!reserveTexture()) {
+		return NULL;
+	}
+
+	char *copy = SDL_strdup(path);
+	if (copy == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	texture = eng_createTextureFromSurface(renderer, surface);
+	if (texture == NULL) {
+		SDL_free(copy);
+		eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to upload %s", path);
+		return NULL;
+	}
+	eng_applyTextureFilter(texture);
+	addTexture(renderer, copy, texture);
+
+	return texture;
+}
+
+static uint32_t findEntry(SDL_Texture *texture, bool orphaned) {
+	for (uint32_t i = 0; i < textureCount; i++) {
+		if (textures[i].texture == texture && textures[i].orphaned == orphaned) {
+			return i;
+		}
+	}
+
+	return NO_TEXTURE;
+}
+
+void eng_releaseTexture(SDL_Texture *texture) {
+	if (texture == NULL) {
+		return;
+	}
+
+	// Live entries first, a new texture can reuse the address of an orphaned one
+	uint32_t i = findEntry(texture, false);
+	if (i == NO_TEXTURE) {
+		i = findEntry(texture, true);
+	}
+	if (i != NO_TEXTURE) {
+		CachedTexture *cached = &textures[i];
+		if (cached->references > 0 && --cached->references == 0) {
+			memory.unusedTextures++;
+			memory.unusedTextureBytes += cached->bytes;
+			cached->lastUsed = ++useClock;
+
+			if (cached->stale || memory.categories[ENG_MEMORY_TEXTURES].budget == 0) {
+				removeTexture(i);
+			} else {
+				evictTextures();
+			}
+		}
+		return;
+	}
+
+	// Not from the cache, nothing else uses it
+	eng_destroyTexture(texture);
+}
+
+void eng_invalidateCachedTexture(const char *path) {
+	// Backwards so removing an entry doesn't skip the one swapped into its place
+	for (uint32_t i = textureCount; i > 0; i--) {
+		CachedTexture *cached = &textures[i - 1];
+		if (cached->stale || strcmp(cached->path, path) != 0) {
+			continue;
+		}
+
+		cached->stale = true;
+		if (cached->references == 0) {
+			removeTexture(i - 1);
+		}
+	}
+}
+
+TTF_Font *eng_acquireFont(const char *path, uint32_t size) {
+	for (uint32_t i = 0; i < fontCount; i++) {
+		if (!fonts[i].stale && fonts[i].size == size && strcmp(fonts[i].path, path) == 0) {
+			fonts[i].references++;
+			return fonts[i].font;
+		}
+	}
+
+	if (fontCount == fontCapacity) {
+		uint32_t newCapacity = fontCapacity == 0 ? 8 : fontCapacity * 2;
+		CachedFont *newFonts = realloc(fonts, newCapacity * sizeof(CachedFont));
+		if (newFonts == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			return NULL;
+		}
+		fonts = newFonts;
+		fontCapacity = newCapacity;
+	}
+
+	char *copy = SDL_strdup(path);
+	if (copy == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	TTF_Font *font = TTF_OpenFont(path, size);
+	if (font == NULL) {
+		SDL_free(copy);
+		eng_setErrorDetail(FAILED_TO_OPEN_FONT, "%s at size %u", path, size);
+		return NULL;
+	}
+
+	SDL_PathInfo info;
+	uint64_t bytes = SDL_GetPathInfo(path, &info) ? info.size : 0;
+	eng_trackMemory(ENG_MEMORY_FONTS, (int64_t)bytes, 1);
+
+	fonts[fontCount++] = (CachedFont) {
+		.path = copy,
+		.size = size,
+		.font = font,
+		.bytes = bytes,
+		.references = 1,
+	};
+
+	return font;
+}
+
+static void closeFont(uint32_t index) {
+	eng_trackMemory(ENG_MEMORY_FONTS, -(int64_t)fonts[index].bytes, -1);
+	TTF_CloseFont(fonts[index].font);
+	SDL_free(fonts[index].path);
+	fonts[index] = fonts[--fontCount];
+}
+
+void eng_releaseFont(TTF_Font *font) {
+	if (font == NULL) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < fontCount; i++) {
+		if (fonts[i].font == font) {
+			if (--fonts[i].references == 0) {
+				closeFont(i);
+			}
+			return;
+		}
+	}
+
+	TTF_CloseFont(font);
+}
+
+// Fonts are closed as soon as nothing uses them, so every cached font still has a text that will release it
+void eng_invalidateCachedFont(const char *path) {
+	for (uint32_t i = 0; i < fontCount; i++) {
+		if (strcmp(fonts[i].path, path) == 0) {
+			fonts[i].stale = true;
+		}
+	}
+}
+
+void eng_getMemoryStats(eng_MemoryStats *stats) {
+	if (stats == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	*stats = memory;
+}
+
+void eng_setMemoryBudget(ENG_MEMORY_CATEGORY category, uint64_t bytes) {
+	if (category >= ENG_MEMORY_CATEGORY_COUNT) {
+		eng_setError(INVALID_TYPE);
+		return;
+	}
+
+	memory.categories[category].budget = bytes;
+	overBudget[category] = false;
+
+	if (category != ENG_MEMORY_TEXTURES) {
+		return;
+	}
+
+	// Without a budget nothing is kept around unused
+	if (bytes == 0) {
+		for (uint32_t i = textureCount; i > 0; i--) {
+			if (textures[i - 1].references == 0) {
+				removeTexture(i - 1);
+			}
+		}
+	} else {
+		evictTextures();
+	}
+}
+
+void eng_resetMemoryPeaks() {
+	for (uint32_t i = 0; i < ENG_MEMORY_CATEGORY_COUNT; i++) {
+		memory.categories[i].peakBytes = memory.categories[i].bytes;
+		memory.categories[i].peakCount = memory.categories[i].count;
+	}
+	memory.peakTotalBytes = memory.totalBytes;
+}
+
+void eng_destroyMemoryCaches() {
+	while (textureCount > 0) {
+		CachedTexture *cached = &textures[textureCount - 1];
+		if (cached->references > 0) {
+			eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Texture %s was still used by %u images", cached->path, cached->references);
+			cached->references = 0;
+			memory.unusedTextures++;
+			memory.unusedTextureBytes += cached->bytes;
+		}
+		removeTexture(textureCount - 1);
+	}
+	free(textures);
+	textures = NULL;
+	textureCapacity = 0;
+
+	while (fontCount > 0) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Font %s at size %u was still used %u times", fonts[fontCount - 1].path, fonts[fontCount - 1].size,
+			fonts[fontCount - 1].references);
+		closeFont(fontCount - 1);
+	}
+	free(fonts);
+	fonts = NULL;
+	fontCapacity = 0;
+}
+
+void eng_destroyRendererTextures(SDL_Renderer *renderer) {
+	for (uint32_t i = textureCount; i > 0; i--) {
+		CachedTexture *cached = &textures[i - 1];
+		if (cached->renderer != renderer) {
+			continue;
+		}
+
+		// SDL_DestroyRenderer frees the texture, the entry stays until its users release it so they don't free it again
+		if (cached->references > 0) {
+			eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Texture %s was still used by %u images when its renderer was destroyed", cached->path,
+				cached->references);
+			eng_trackMemory(ENG_MEMORY_TEXTURES, -(int64_t)cached->bytes, -1);
+			cached->renderer = NULL;
+			cached->stale = true;
+			cached->orphaned = true;
+			continue;
+		}
+		removeTexture(i - 1);
+	}
+}
+
+void eng_reportMemory() {
+	for (uint32_t i = 0; i < ENG_MEMORY_CATEGORY_COUNT; i++) {
+		eng_MemoryUsage *usage = &memory.categories[i];
+		if (usage->count > 0 || usage->bytes > 0) {
+			eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "Leaked %u %s\tBytes: %llu", usage->count, eng_getMemoryCategoryName(i), (unsigned long long)usage->bytes);
+		}
+		eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Peak %s\tBytes: %llu\tCount: %u", eng_getMemoryCategoryName(i), (unsigned long long)usage->peakBytes, usage->peakCount);
+	}
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Peak memory\tBytes: %llu\tTextures reused: %u\tEvicted: %u", (unsigned long long)memory.peakTotalBytes,
+		memory.textureHits, memory.evictions);
+}
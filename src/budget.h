@@ -0,0 +1,62 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include "engine.h"
+
+/*
+* Memory accounting and budgets for devices with little memory.
+*
+* The engine counts what it allocates for textures, fonts, render queue nodes, object pools and sounds and remembers the highest
+* value each category reached. Textures are counted as 4 bytes a pixel, the driver may keep more. Fonts are counted as the size of the font file.
+*
+* Images made from the same file share one texture and texts with the same font and size share one font. With a texture budget set,
+* textures no image uses any more are kept so the image can be made again without loading it, the least recently used ones are freed
+* as soon as the budget is exceeded. Without a texture budget they're freed straight away. The other budgets only log a warning when crossed.
+*
+* eng_quit destroys and logs every object that was never removed and logs any memory still counted after it shut everything down.
+*/
+
+typedef enum {
+	ENG_MEMORY_TEXTURES,
+	ENG_MEMORY_FONTS,
+	ENG_MEMORY_QUEUE,
+	ENG_MEMORY_POOLS, // Handle table, tweeners and physics worlds
+	ENG_MEMORY_SOUNDS,
+	ENG_MEMORY_CATEGORY_COUNT,
+} ENG_MEMORY_CATEGORY;
+
+typedef struct {
+	uint64_t bytes;
+	uint64_t peakBytes;
+	uint32_t count;
+	uint32_t peakCount;
+	uint64_t budget; // 0 if there's no budget
+} eng_MemoryUsage;
+
+typedef struct {
+	eng_MemoryUsage categories[ENG_MEMORY_CATEGORY_COUNT];
+	uint64_t totalBytes;
+	uint64_t peakTotalBytes;
+
+	// Textures kept for reuse under the texture budget that nothing is using
+	uint32_t unusedTextures;
+	uint64_t unusedTextureBytes;
+	uint32_t textureHits;
+	uint32_t evictions;
+} eng_MemoryStats;
+
+void eng_getMemoryStats(eng_MemoryStats *stats);
+
+/*
+* Sets the budget for a category in bytes, 0 removes it. Lowering the texture budget frees unused textures straight away
+*/
+void eng_setMemoryBudget(ENG_MEMORY_CATEGORY category, uint64_t bytes);
+
+/*
+* Starts the high-water marks again from the current values, call it between levels to measure each one
+*/
+void eng_resetMemoryPeaks();
+
+const char *eng_getMemoryCategoryName(ENG_MEMORY_CATEGORY category);
+
+#endif
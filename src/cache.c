@@ -0,0 +1,222 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "cache.h"
+
+static char *textureCacheDirectory = NULL;
+
+typedef struct {
+	const char *cacheDirectory;
+	uint32_t count;
+	ENG_RESULT result;
+} CookState;
+
+static bool getCachePath(char *cachePath, size_t length, const char *directory, uint64_t hash) {
+	char name[64];
+	SDL_snprintf(name, sizeof(name), "%016llx%s", (unsigned long long)hash, ENG_TEXTURE_CACHE_EXTENSION);
+
+	return eng_joinPath(cachePath, length, directory, name);
+}
+
+uint64_t eng_hashData(const void *data, size_t size) {
+	const uint8_t *bytes = data;
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+ENG_RESULT eng_setTextureCache(const char *directory) {
+	free(textureCacheDirectory);
+	textureCacheDirectory = NULL;
+
+	if (directory == NULL) {
+		return SUCCESS;
+	}
+
+	size_t length = strlen(directory) + 1;
+	textureCacheDirectory = (char *)malloc(length);
+	if (textureCacheDirectory == NULL) {
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+	memcpy(textureCacheDirectory, directory, length);
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Using texture cache %s", textureCacheDirectory);
+
+	return SUCCESS;
+}
+
+SDL_Texture *eng_loadCachedTexture(SDL_Renderer *renderer, const void *source, size_t sourceSize) {
+	if (textureCacheDirectory == NULL) {
+		return NULL;
+	}
+
+	uint64_t hash = eng_hashData(source, sourceSize);
+	char cachePath[1024];
+	if (!getCachePath(cachePath, sizeof(cachePath), textureCacheDirectory, hash)) {
+		return NULL;
+	}
+
+	size_t size;
+	uint8_t *data = SDL_LoadFile(cachePath, &size);
+	if (data == NULL) {
+		return NULL;
+	}
+
+	eng_TextureCacheHeader *header = (eng_TextureCacheHeader *)data;
+	if (size < sizeof(eng_TextureCacheHeader)
+		|| header->magic != ENG_TEXTURE_CACHE_MAGIC
+		|| header->version != ENG_TEXTURE_CACHE_VERSION
+		|| header->sourceHash != hash
+		|| header->sourceSize != sourceSize
+		|| header->format != SDL_PIXELFORMAT_RGBA32
+		|| header->pitch < (uint64_t)header->width * 4
+		|| size - sizeof(eng_TextureCacheHeader) < (uint64_t)header->pitch * header->height) {
+		eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Ignoring stale texture cache %s", cachePath);
+		SDL_free(data);
+		return NULL;
+	}
+
+	SDL_Texture *texture = SDL_CreateTexture(renderer, header->format, SDL_TEXTUREACCESS_STATIC, header->width, header->height);
+	if (texture == NULL) {
+		SDL_free(data);
+		return NULL;
+	}
+
+	if (!SDL_UpdateTexture(texture, NULL, data + sizeof(eng_TextureCacheHeader), header->pitch)) {
+		SDL_DestroyTexture(texture);
+		SDL_free(data);
+		return NULL;
+	}
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+	SDL_free(data);
+
+	return texture;
+}
+
+ENG_RESULT eng_cookTexture(const char *path, const char *cacheDirectory) {
+	if (path == NULL || cacheDirectory == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	size_t sourceSize;
+	void *source = SDL_LoadFile(path, &sourceSize);
+	if (source == NULL) {
+		return eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "%s", path);
+	}
+
+	uint64_t hash = eng_hashData(source, sourceSize);
+	SDL_Surface *loaded = IMG_Load_IO(SDL_IOFromConstMem(source, sourceSize), true);
+	SDL_free(source);
+	if (loaded == NULL) {
+		return eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to decode %s", path);
+	}
+
+	SDL_Surface *surface = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+	SDL_DestroySurface(loaded);
+	if (surface == NULL || !SDL_PremultiplySurfaceAlpha(surface, false)) {
+		SDL_DestroySurface(surface);
+		return eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to convert %s", path);
+	}
+
+	eng_TextureCacheHeader header = (eng_TextureCacheHeader) {
+		.magic = ENG_TEXTURE_CACHE_MAGIC,
+		.version = ENG_TEXTURE_CACHE_VERSION,
+		.width = surface->w,
+		.height = surface->h,
+		.pitch = surface->w * 4,
+		.format = SDL_PIXELFORMAT_RGBA32,
+		.sourceSize = sourceSize,
+		.sourceHash = hash,
+	};
+
+	char cachePath[1024];
+	if (!getCachePath(cachePath, sizeof(cachePath), cacheDirectory, hash)) {
+		SDL_DestroySurface(surface);
+		return eng_setErrorDetail(FAILED_TO_WRITE_TEXTURE_CACHE, "Cache path is too long for %s", cacheDirectory);
+	}
+
+	SDL_IOStream *file = SDL_IOFromFile(cachePath, "wb");
+	if (file == NULL) {
+		SDL_DestroySurface(surface);
+		return eng_setErrorDetail(FAILED_TO_WRITE_TEXTURE_CACHE, "%s", cachePath);
+	}
+
+	bool success = SDL_WriteIO(file, &header, sizeof(header)) == sizeof(header);
+	for (int y = 0; y < surface->h && success; y++) {
+		const uint8_t *row = (const uint8_t *)surface->pixels + (size_t)y * surface->pitch;
+		success = SDL_WriteIO(file, row, header.pitch) == header.pitch;
+	}
+	SDL_DestroySurface(surface);
+
+	if (!SDL_CloseIO(file) || !success) {
+		return eng_setErrorDetail(FAILED_TO_WRITE_TEXTURE_CACHE, "%s", cachePath);
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Cooked %s\t-> %s", path, cachePath);
+
+	return SUCCESS;
+}
+
+static SDL_EnumerationResult cookEntry(void *userdata, const char *dirname, const char *fname) {
+	CookState *state = userdata;
+
+	char path[1024];
+	if (!eng_joinPath(path, sizeof(path), dirname, fname)) {
+		return SDL_ENUM_CONTINUE;
+	}
+
+	SDL_PathInfo info;
+	if (!SDL_GetPathInfo(path, &info)) {
+		return SDL_ENUM_CONTINUE;
+	}
+
+	if (info.type == SDL_PATHTYPE_DIRECTORY) {
+		SDL_EnumerateDirectory(path, cookEntry, state);
+	} else if (info.type == SDL_PATHTYPE_FILE && eng_hasExtension(path, ".png")) {
+		ENG_RESULT result = eng_cookTexture(path, state->cacheDirectory);
+		if (result == SUCCESS) {
+			state->count++;
+		} else {
+			state->result = result;
+		}
+	}
+
+	return SDL_ENUM_CONTINUE;
+}
+
+ENG_RESULT eng_cookDirectory(const char *directory, const char *cacheDirectory, uint32_t *count) {
+	if (directory == NULL || cacheDirectory == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	SDL_CreateDirectory(cacheDirectory);
+
+	CookState state = (CookState) {
+		.cacheDirectory = cacheDirectory,
+		.count = 0,
+		.result = SUCCESS,
+	};
+
+	if (!SDL_EnumerateDirectory(directory, cookEntry, &state)) {
+		state.result = eng_setError(FAILED_TO_LOAD_IMAGE);
+	}
+
+	if (count) {
+		*count = state.count;
+	}
+
+	return state.result;
+}
@@ -0,0 +1,52 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "engine.h"
+
+/*
+* Pre-baked textures, images are cooked ahead of time into premultiplied RGBA so loading them skips the PNG decode.
+*
+* Cached files are named after a hash of the source file's contents, so a changed image simply misses the cache and falls back to the PNG.
+*/
+
+#define ENG_TEXTURE_CACHE_MAGIC 0x54474E45 // "ENGT"
+#define ENG_TEXTURE_CACHE_VERSION 1
+#define ENG_TEXTURE_CACHE_EXTENSION ".engtex"
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t width;
+	uint32_t height;
+	uint32_t pitch;
+	uint32_t format;
+	uint64_t sourceSize;
+	uint64_t sourceHash;
+} eng_TextureCacheHeader;
+
+/*
+* Sets the directory cooked textures are read from, NULL turns the cache off
+*/
+ENG_RESULT eng_setTextureCache(const char *directory);
+
+/*
+* Hashes a block of memory, this is the content hash stored in cooked textures
+*/
+uint64_t eng_hashData(const void *data, size_t size);
+
+/*
+* Cooks a single image into the cache directory
+*/
+ENG_RESULT eng_cookTexture(const char *path, const char *cacheDirectory);
+
+/*
+* Cooks every PNG in a directory and all of its subdirectories, count is set to how many images were cooked
+*/
+ENG_RESULT eng_cookDirectory(const char *directory, const char *cacheDirectory, uint32_t *count);
+
+/*
+* Creates a texture from the cache using the bytes of the source file, returns NULL without setting an error if there is no usable cached copy
+*/
+SDL_Texture *eng_loadCachedTexture(SDL_Renderer *renderer, const void *source, size_t sourceSize);
+
+#endif
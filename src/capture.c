@@ -0,0 +1,153 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "capture.h"
+
+static SDL_Surface *readFrame(Application *app) {
+	SDL_Surface *pixels = SDL_RenderReadPixels(app->window->pRenderer, NULL);
+	if (pixels == NULL) {
+		eng_setError(FAILED_TO_CAPTURE_FRAME);
+		return NULL;
+	}
+
+	SDL_Surface *frame = SDL_ConvertSurface(pixels, SDL_PIXELFORMAT_RGBA32);
+	SDL_DestroySurface(pixels);
+	if (frame == NULL) {
+		eng_setError(FAILED_TO_CAPTURE_FRAME);
+	}
+
+	return frame;
+}
+
+SDL_Surface *eng_captureFrame(Application *app, eng_Color backgroundColor) {
+	if (app == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	eng_drawRenderQueue(app, backgroundColor);
+
+	return readFrame(app);
+}
+
+ENG_RESULT eng_saveFrame(SDL_Surface *frame, const char *path) {
+	if (frame == NULL || path == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (!IMG_SavePNG(frame, path)) {
+		return eng_setError(FAILED_TO_CAPTURE_FRAME);
+	}
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_compareFrame(SDL_Surface *frame, const char *goldenPath, uint8_t tolerance, eng_FrameDiff *diff) {
+	if (frame == NULL || goldenPath == NULL || diff == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	SDL_Surface *loaded = IMG_Load(goldenPath);
+	if (loaded == NULL) {
+		return eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "%s", goldenPath);
+	}
+
+	SDL_Surface *golden = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+	SDL_DestroySurface(loaded);
+	SDL_Surface *actual = frame->format == SDL_PIXELFORMAT_RGBA32 ? frame : SDL_ConvertSurface(frame, SDL_PIXELFORMAT_RGBA32);
+	if (golden == NULL || actual == NULL) {
+		SDL_DestroySurface(golden);
+		return eng_setError(FAILED_TO_LOAD_IMAGE);
+	}
+
+	if (golden->w != actual->w || golden->h != actual->h) {
+		SDL_DestroySurface(golden);
+		if (actual != frame) {
+			SDL_DestroySurface(actual);
+		}
+		return eng_setErrorDetail(FRAME_SIZE_MISMATCH, "Frame is %dx%d, %s is %dx%d", actual->w, actual->h, goldenPath, golden->w, golden->h);
+	}
+
+	*diff = (eng_FrameDiff) {
+		.totalPixels = actual->w * actual->h,
+		.mismatchedPixels = 0,
+		.maxDifference = 0,
+	};
+
+	for (int y = 0; y < actual->h; y++) {
+		const uint8_t *actualRow = (const uint8_t *)actual->pixels + (size_t)y * actual->pitch;
+		const uint8_t *goldenRow = (const uint8_t *)golden->pixels + (size_t)y * golden->pitch;
+
+		for (int x = 0; x < actual->w; x++) {
+			uint8_t pixelDifference = 0;
+			for (int channel = 0; channel < 4; channel++) {
+				int difference = abs((int)actualRow[x * 4 + channel] - (int)goldenRow[x * 4 + channel]);
+				if (difference > pixelDifference) {
+					pixelDifference = difference;
+				}
+			}
+
+			if (pixelDifference > diff->maxDifference) {
+				diff->maxDifference = pixelDifference;
+			}
+			if (pixelDifference > tolerance) {
+				diff->mismatchedPixels++;
+			}
+		}
+	}
+	diff->passed = diff->mismatchedPixels == 0;
+
+	SDL_DestroySurface(golden);
+	if (actual != frame) {
+		SDL_DestroySurface(actual);
+	}
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_checkFrame(Application *app, eng_Color backgroundColor, const char *goldenPath, uint8_t tolerance, bool record, eng_FrameCheck *check) {
+	if (app == NULL || goldenPath == NULL || check == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	*check = (eng_FrameCheck) {0};
+
+	// Rendering is deferred until the renderer is flushed, so the flush has to be inside the timing
+	uint64_t start = SDL_GetTicksNS();
+	eng_drawRenderQueue(app, backgroundColor);
+	SDL_FlushRenderer(app->window->pRenderer);
+	check->frameNS = SDL_GetTicksNS() - start;
+
+	SDL_Surface *frame = readFrame(app);
+	if (frame == NULL) {
+		return FAILED_TO_CAPTURE_FRAME;
+	}
+
+	ENG_RESULT result;
+	SDL_PathInfo info;
+	if (record) {
+		result = eng_saveFrame(frame, goldenPath);
+		check->recorded = result == SUCCESS;
+		check->diff = (eng_FrameDiff) {
+			.totalPixels = frame->w * frame->h,
+			.passed = check->recorded,
+		};
+	} else if (!SDL_GetPathInfo(goldenPath, &info)) {
+		result = eng_setErrorDetail(MISSING_GOLDEN_IMAGE, "%s", goldenPath);
+	} else {
+		result = eng_compareFrame(frame, goldenPath, tolerance, &check->diff);
+	}
+	SDL_DestroySurface(frame);
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_RENDER, "Frame check %s\t%s\tMismatched: %d\tFrame: %.3f ms", goldenPath, check->recorded ? "Recorded" : (check->diff.passed ? "Passed" : "Failed"), check->diff.mismatchedPixels, (double)check->frameNS / SDL_NS_PER_MS);
+
+	return result;
+}
@@ -0,0 +1,44 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "engine.h"
+
+/*
+* Frame capture for checking rendering output, meant to be used with eng_createHeadlessApplication so results don't depend on a GPU.
+*
+* Build a scene in the render queue, then call eng_checkFrame with a golden image. A missing golden image fails the check, golden images are only
+* written when recording is asked for, so a deleted or misnamed golden image can't turn into a pass.
+*/
+
+typedef struct {
+	uint32_t totalPixels;
+	uint32_t mismatchedPixels;
+	uint8_t maxDifference;
+	bool passed;
+} eng_FrameDiff;
+
+typedef struct {
+	eng_FrameDiff diff;
+	uint64_t frameNS;
+	bool recorded;
+} eng_FrameCheck;
+
+/*
+* Draws the render queue and reads the pixels back, the surface is RGBA32 and must be freed with SDL_DestroySurface
+*/
+SDL_Surface *eng_captureFrame(Application *app, eng_Color backgroundColor);
+
+ENG_RESULT eng_saveFrame(SDL_Surface *frame, const char *path);
+
+/*
+* Compares a frame with a golden image, a pixel matches when every channel is within tolerance
+*/
+ENG_RESULT eng_compareFrame(SDL_Surface *frame, const char *goldenPath, uint8_t tolerance, eng_FrameDiff *diff);
+
+/*
+* Draws, times and compares a single frame against a golden image, check.frameNS is how long drawing the queue took.
+* With record the frame is saved as the golden image instead, replacing an existing one. Without it a missing golden image returns MISSING_GOLDEN_IMAGE
+*/
+ENG_RESULT eng_checkFrame(Application *app, eng_Color backgroundColor, const char *goldenPath, uint8_t tolerance, bool record, eng_FrameCheck *check);
+
+#endif
@@ -0,0 +1,138 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "cache.h"
+
+/*
+* Asset cooker, run it on the images directory at build time:
+*   cook <images directory> <cache directory>
+*   cook --bench <images directory> <cache directory>
+*/
+
+#define BENCH_PASSES 3
+
+typedef struct {
+	char **paths;
+	uint32_t count;
+	uint32_t capacity;
+} ImageList;
+
+static SDL_EnumerationResult collectImage(void *userdata, const char *dirname, const char *fname) {
+	ImageList *list = userdata;
+
+	char path[1024];
+	SDL_PathInfo info;
+	if (!eng_joinPath(path, sizeof(path), dirname, fname) || !SDL_GetPathInfo(path, &info)) {
+		return SDL_ENUM_CONTINUE;
+	}
+
+	if (info.type == SDL_PATHTYPE_DIRECTORY) {
+		SDL_EnumerateDirectory(path, collectImage, list);
+		return SDL_ENUM_CONTINUE;
+	}
+
+	if (!eng_hasExtension(path, ".png")) {
+		return SDL_ENUM_CONTINUE;
+	}
+
+	if (list->count == list->capacity) {
+		uint32_t capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+		char **paths = realloc(list->paths, capacity * sizeof(char *));
+		if (paths == NULL) {
+			return SDL_ENUM_FAILURE;
+		}
+		list->paths = paths;
+		list->capacity = capacity;
+	}
+	list->paths[list->count++] = SDL_strdup(path);
+
+	return SDL_ENUM_CONTINUE;
+}
+
+static double loadAll(SDL_Renderer *renderer, ImageList *list) {
+	double fastest = 0;
+
+	for (int pass = 0; pass < BENCH_PASSES; pass++) {
+		uint64_t start = SDL_GetTicksNS();
+		for (uint32_t i = 0; i < list->count; i++) {
+			SDL_Texture *texture = eng_loadTexture(renderer, list->paths[i]);
+			eng_destroyTexture(texture);
+		}
+		double ms = (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+
+		if (pass == 0 || ms < fastest) {
+			fastest = ms;
+		}
+	}
+
+	return fastest;
+}
+
+static int bench(const char *imageDirectory, const char *cacheDirectory) {
+	SDL_Window *window = SDL_CreateWindow("cook", 64, 64, SDL_WINDOW_HIDDEN);
+	SDL_Renderer *renderer = window ? SDL_CreateRenderer(window, NULL) : NULL;
+	if (renderer == NULL) {
+		printf("Failed to create a renderer: %s\n", SDL_GetError());
+		return 1;
+	}
+
+	ImageList list = {0};
+	SDL_EnumerateDirectory(imageDirectory, collectImage, &list);
+
+	eng_setTextureCache(NULL);
+	double pngMs = loadAll(renderer, &list);
+
+	eng_setTextureCache(cacheDirectory);
+	double cacheMs = loadAll(renderer, &list);
+
+	printf("Images:\t\t%d\n", list.count);
+	printf("PNG decode:\t%.2f ms\n", pngMs);
+	printf("Texture cache:\t%.2f ms\n", cacheMs);
+	if (cacheMs > 0) {
+		printf("Speedup:\t%.2fx\n", pngMs / cacheMs);
+	}
+
+	for (uint32_t i = 0; i < list.count; i++) {
+		SDL_free(list.paths[i]);
+	}
+	free(list.paths);
+
+	SDL_DestroyRenderer(renderer);
+	SDL_DestroyWindow(window);
+
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	bool benchmark = argc == 4 && strcmp(argv[1], "--bench") == 0;
+	if (argc != 3 && !benchmark) {
+		printf("Usage: %s [--bench] <images directory> <cache directory>\n", argv[0]);
+		return 1;
+	}
+
+	if (eng_init(false) != SUCCESS) {
+		printf("%s\n", eng_getError());
+		return 1;
+	}
+
+	int status = 0;
+	if (benchmark) {
+		status = bench(argv[2], argv[3]);
+	} else {
+		uint32_t count = 0;
+		if (eng_cookDirectory(argv[1], argv[2], &count) != SUCCESS) {
+			printf("ERROR: %s\n", eng_getError());
+			status = 1;
+		}
+		printf("Cooked %d images into %s\n", count, argv[2]);
+	}
+
+	eng_quit(NULL);
+
+	return status;
+}
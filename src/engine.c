@@ -5,143 +5,476 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdarg.h>
 
 #include "engine.h"
+#include "internal.h"
+#include "scene.h"
+#include "cache.h"
+#include "hotreload.h"
+#include "batch.h"
+#include "replay.h"
+#include "hud.h"
+#include "log.h"
+#include "handle.h"
+#include "present.h"
+#include "ui.h"
+#include "stream.h"
+#include "postfx.h"
 #include "SDL3/SDL_mouse.h"
 #include "SDL3/SDL_video.h"
 
-
-static ENG_RESULT errorCode = SUCCESS;
-static SDL_Event e;
+#define PENDING_EVENTS 64
+
+// Each thread has its own error so loading on worker threads can't overwrite the main thread's error
+typedef struct {
+	ENG_RESULT code;
+	char detail[ENG_ERROR_DETAIL_LENGTH];
+	char sdlError[ENG_ERROR_DETAIL_LENGTH];
+} ErrorState;
+
+// Everything that belongs to one application, so several windows or offscreen renderers can run side by side
+struct eng_Context {
+	Window *window;
+	SDL_Event event;
+
+	// Events SDL handed to another context that were meant for this window, oldest first
+	SDL_Event pending[PENDING_EVENTS];
+	uint32_t pendingStart;
+	uint32_t pendingCount;
+
+	uint64_t nsPerFrame;
+	uint64_t renderingNS;
+	uint64_t endingNS;
+	uint64_t sleptNS;
+
+	RenderQueue *renderQueue;
+	RenderQueue *renderQueueTail;
+	uint32_t renderQueueCount;
+	uint32_t layoutVersion; // Goes up when the render queue's layout changes, see eng_getQueueVersion
+
+	// Simulations skip events and frame limiting and only draw every renderEvery frames, never if it's 0
+	bool simulated;
+	uint32_t renderEvery;
+	uint64_t frame;
+
+	struct eng_Context *pNextContext;
+};
+
+static SDL_TLSID errorState;
+static ErrorState fallbackErrorState;
+static void *errorCallback = NULL;
 static bool debug = false;
 
-static uint32_t nsPerFrame;
-static uint32_t renderingNS = 0;
-static uint32_t endingNS = 0;
-
-static RenderQueue *renderQueue = NULL;
-static uint32_t renderQueueCount = 0;
+// The first application's context, it owns the presentation, HUD and hot reload and is the head of the list of contexts
+static eng_Context mainContext;
+static SDL_TLSID currentContext;
 Mouse eng_getMousePosition();
 
 
 
-static RenderQueue *getObjectFromPointer(void *data) {
-	RenderQueue *temp = renderQueue;
-	RenderQueue *prev = temp;
-	bool success = false;
-	int positions = 0;
+static ErrorState *getErrorState() {
+	ErrorState *state = (ErrorState *)SDL_GetTLS(&errorState);
+	if (state != NULL) {
+		return state;
+	}
+
+	state = (ErrorState *)calloc(1, sizeof(ErrorState));
+	if (state == NULL || !SDL_SetTLS(&errorState, state, free)) {
+		free(state);
+		return &fallbackErrorState;
+	}
+
+	return state;
+}
+
+static const char *getErrorMessage(ENG_RESULT code);
+
+static ENG_RESULT storeError(ENG_RESULT code, const char *detail) {
+	ErrorState *state = getErrorState();
+	state->code = code;
+	state->detail[0] = '\0';
+	state->sdlError[0] = '\0';
+	if (code == SUCCESS) {
+		return code;
+	}
+
+	if (detail != NULL) {
+		SDL_strlcpy(state->detail, detail, sizeof(state->detail));
+	}
+	SDL_strlcpy(state->sdlError, SDL_GetError(), sizeof(state->sdlError));
+
+	eng_log(ENG_LOG_ERROR, ENG_LOG_CORE, "%s\t%s\t%s", getErrorMessage(code), state->detail, state->sdlError);
 
-	if (temp->data == data) {
-		return temp;
+	eng_ErrorCallback callback = (eng_ErrorCallback)SDL_GetAtomicPointer(&errorCallback);
+	if (callback != NULL) {
+		callback(code, getErrorMessage(code), state->detail);
 	}
 
-	while (temp != NULL && success == false) {
+	return code;
+}
+
+ENG_RESULT eng_setError(ENG_RESULT code) {
+	return storeError(code, NULL);
+}
+
+ENG_RESULT eng_setErrorDetail(ENG_RESULT code, const char *format, ...) {
+	char detail[ENG_ERROR_DETAIL_LENGTH];
+	va_list args;
+	va_start(args, format);
+	SDL_vsnprintf(detail, sizeof(detail), format, args);
+	va_end(args);
+
+	return storeError(code, detail);
+}
+
+ENG_RESULT eng_getErrorCode() {
+	return getErrorState()->code;
+}
+
+const char *eng_getErrorDetail() {
+	return getErrorState()->detail;
+}
+
+const char *eng_getErrorSDL() {
+	return getErrorState()->sdlError;
+}
+
+void eng_clearError() {
+	eng_setError(SUCCESS);
+}
+
+void eng_setErrorCallback(eng_ErrorCallback callback) {
+	SDL_SetAtomicPointer(&errorCallback, (void *)callback);
+}
+
+void eng_setCurrentContext(eng_Context *context) {
+	SDL_SetTLS(&currentContext, context, NULL);
+}
+
+eng_Context *eng_getCurrentContext() {
+	eng_Context *context = (eng_Context *)SDL_GetTLS(&currentContext);
+	return context != NULL ? context : &mainContext;
+}
+
+bool eng_isDebug() {
+	return debug;
+}
+
+bool eng_hasExtension(const char *path, const char *extension) {
+	size_t pathLength = strlen(path);
+	size_t extensionLength = strlen(extension);
+	if (pathLength < extensionLength) {
+		return false;
+	}
+
+	const char *end = path + pathLength - extensionLength;
+	for (size_t i = 0; i < extensionLength; i++) {
+		char c = end[i];
+		if (c >= 'A' && c <= 'Z') {
+			c += 'a' - 'A';
+		}
+		if (c != extension[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool eng_joinPath(char *path, size_t length, const char *directory, const char *name) {
+	size_t directoryLength = strlen(directory);
+	const char *separator = (directoryLength > 0 && directory[directoryLength - 1] != '/' && directory[directoryLength - 1] != '\\') ? "/" : "";
+
+	int written = SDL_snprintf(path, length, "%s%s%s", directory, separator, name);
+
+	return written > 0 && (size_t)written < length;
+}
+
+uint32_t eng_packColor(eng_Color color) {
+	return ((uint32_t)(color.r & 0xFF) << 24) | ((uint32_t)(color.g & 0xFF) << 16) | ((uint32_t)(color.b & 0xFF) << 8) | (uint32_t)(color.a & 0xFF);
+}
+
+eng_Color eng_unpackColor(uint32_t color) {
+	return (eng_Color) {
+		.r = (color >> 24) & 0xFF,
+		.g = (color >> 16) & 0xFF,
+		.b = (color >> 8) & 0xFF,
+		.a = color & 0xFF,
+	};
+}
+
+static eng_Handle getObjectHandle(Type type, void *data) {
+	switch (type) {
+		case TYPE_RECT:
+			return ((eng_Rect *)data)->handle;
+		case TYPE_TEXTURE:
+			return ((eng_Texture *)data)->handle;
+		case TYPE_TEXT:
+			return ((eng_Text *)data)->handle;
+		default:
+			return ENG_INVALID_HANDLE;
+	}
+}
+
+// Rounds positions to whole pixels in pixel art mode so sprites don't shimmer between pixels
+static float snap(float position) {
+	return eng_isPixelArt() ? SDL_roundf(position) : position;
+}
+
+static void renderObject(SDL_Renderer *renderer, Type type, void *data) {
+	if (data == NULL) {
+		return;
+	}
+
+	if (type == TYPE_RECT) {
+		eng_Rect *rect = data;
+		SDL_FRect frect = (SDL_FRect) {
+			.h = rect->h,
+			.w = rect->w,
+			.x = snap(rect->x),
+			.y = snap(rect->y),
+		};
+
+		// Opaque rects skip blending, it's the common case and costs the software renderer a read per pixel
+		SDL_BlendMode previousBlendMode;
+		SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+		SDL_SetRenderDrawBlendMode(renderer, rect->color->a < 255 ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+		SDL_SetRenderDrawColor(renderer, rect->color->r, rect->color->g,rect->color->b, rect->color->a);
+		SDL_RenderFillRect(renderer, &frect);
+		SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+		eng_countDrawCalls(1, 0);
+	} else if (type == TYPE_TEXTURE) {
+		eng_Texture *texture = data;
+		SDL_FRect rect = (SDL_FRect) {
+			.h = texture->h,
+			.w = texture->w,
+			.x = snap(texture->x),
+			.y = snap(texture->y),
+		};
+		SDL_RenderTexture(renderer, texture->texture, NULL, &rect);
+		eng_countDrawCalls(1, 0);
+	} else if (type == TYPE_TEXT) {
+		eng_Text *text = data;
+		SDL_FRect rect = (SDL_FRect) {
+			.h = text->h,
+			.w = text->w,
+			.x = snap(text->x),
+			.y = snap(text->y),
+		};
+		SDL_RenderTexture(renderer, text->texture, NULL, &rect);
+		eng_countDrawCalls(1, 0);
+	} else if (type == TYPE_SCENE) {
+		eng_renderScene(renderer, data);
+	} else if (type == TYPE_RECT_BATCH) {
+		eng_renderRectBatch(renderer, data);
+	} else if (type == TYPE_SPRITE_BATCH) {
+		eng_renderSpriteBatch(renderer, data);
+	} else if (type == TYPE_UI) {
+		eng_renderUI(renderer, data);
+	} else if (type == TYPE_WORLD) {
+		eng_renderWorld(renderer, data);
+	}
+}
+
+static void destroyObject(Type type, void *data) {
+	if (data == NULL) {
+		return;
+	}
+	eng_untrackAsset(data);
+	eng_releaseHandle(getObjectHandle(type, data));
+
+	if (type == TYPE_RECT) {
+		eng_Rect *rect = data;
+		free(rect->color);
+		free(rect);
+	} else if (type == TYPE_TEXTURE) {
+		eng_Texture *texture = data;
+		eng_releaseTexture(texture->texture);
+		free(texture);
+	} else if (type == TYPE_TEXT) {
+		eng_Text *text = data;
+		eng_destroyTexture(text->texture);
+		TTF_Font *font = TTF_GetTextFont(text->text);
+		TTF_DestroyText(text->text);
+		eng_releaseFont(font);
+		free(text);
+	} else if (type == TYPE_SCENE) {
+		eng_destroyScene(data);
+	} else if (type == TYPE_RECT_BATCH) {
+		eng_destroyRectBatch(data);
+	} else if (type == TYPE_SPRITE_BATCH) {
+		eng_destroySpriteBatch(data);
+	} else if (type == TYPE_UI) {
+		eng_destroyUI(data);
+	} else if (type == TYPE_WORLD) {
+		eng_destroyWorld(data);
+	} else {
+		free(data);
+	}
+}
+
+RenderQueue *eng_getRenderQueue() {
+	return eng_getCurrentContext()->renderQueue;
+}
+
+uint32_t eng_getQueueVersion(RenderQueue *queue) {
+	if (queue == NULL) {
+		return eng_getCurrentContext()->layoutVersion;
+	}
+
+	return queue->pContext != NULL ? queue->pContext->layoutVersion : queue->version;
+}
+
+void eng_markQueueChanged(RenderQueue *node) {
+	if (node == NULL) {
+		return;
+	}
+
+	if (node->pContext != NULL) {
+		node->pContext->layoutVersion++;
+	} else if (node->pHead != NULL) {
+		node->pHead->version++;
+	} else {
+		node->version++;
+	}
+}
+
+void eng_markObjectMoved(eng_Handle handle) {
+	if (eng_isHandleValid(handle)) {
+		eng_markQueueChanged(eng_getHandleNode(handle));
+	}
+}
+
+static RenderQueue *findNode(eng_Context *context, void *data) {
+	RenderQueue *temp = context->renderQueue;
+	while (temp != NULL) {
 		if (temp->data == data) {
 			return temp;
 		}
-		prev = temp;
 		temp = temp->pNext;
 	}
 
 	return NULL;
 }
 
-static ENG_RESULT removeFromRenderQueueWithoutFreeing(void *data) {
-	RenderQueue *temp = renderQueue;
-	RenderQueue *prev = temp;
-	bool success = false;
-
-	if (temp->data == data) {
-		renderQueue = temp->pNext;
+static void unlinkNode(RenderQueue *node) {
+	eng_Context *context = node->pContext;
+	if (node->pPrev != NULL) {
+		node->pPrev->pNext = node->pNext;
+	} else {
+		context->renderQueue = node->pNext;
+	}
 
-		success = true;
-		renderQueueCount--;
+	if (node->pNext != NULL) {
+		node->pNext->pPrev = node->pPrev;
+	} else {
+		context->renderQueueTail = node->pPrev;
 	}
 
-	while (temp != NULL && success == false) {
-		if (temp->data == data) {
-			prev->pNext = temp->pNext;
+	node->pNext = NULL;
+	node->pPrev = NULL;
+	context->renderQueueCount--;
+	context->layoutVersion++;
+}
 
-			renderQueueCount--;
-			success = true;
+// Links node in front of next, or at the end if next is NULL
+static void linkNode(eng_Context *context, RenderQueue *node, RenderQueue *next) {
+	node->pContext = context;
+	node->pNext = next;
+	node->pPrev = next != NULL ? next->pPrev : context->renderQueueTail;
 
-			break;
-		}
-		prev = temp;
-		temp = temp->pNext;
+	if (node->pPrev != NULL) {
+		node->pPrev->pNext = node;
+	} else {
+		context->renderQueue = node;
 	}
 
-	if (success != true) {
-		errorCode = FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
-		return FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
+	if (next != NULL) {
+		next->pPrev = node;
+	} else {
+		context->renderQueueTail = node;
 	}
 
+	context->renderQueueCount++;
+	context->layoutVersion++;
+}
+
+static void freeNode(RenderQueue *node) {
+	free(node);
+	eng_trackMemory(ENG_MEMORY_QUEUE, -(int64_t)sizeof(RenderQueue), -1);
+}
+
+static ENG_RESULT removeNode(RenderQueue *node) {
+	eng_Context *context = node->pContext;
+	unlinkNode(node);
+	destroyObject(node->type, node->data);
+	freeNode(node);
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_QUEUE, "Removed from render queue\tCount: %d", context->renderQueueCount);
+
 	return SUCCESS;
 }
 
-static ENG_RESULT addQueueToRenderQueue(RenderQueue *object) {
-	RenderQueue *temp = renderQueue;
-	while (temp->pNext != NULL) {
-		temp = temp->pNext;
+static ENG_RESULT moveNode(RenderQueue *node, int position) {
+	if (position == 0) {
+		return eng_setError(POSITION_CANT_BE_ZERO);
 	}
-	temp->pNext = object;
 
-	renderQueueCount++;
+	eng_Context *context = node->pContext;
+	if ((uint32_t)abs(position) > context->renderQueueCount) {
+		return eng_setError(POSITION_HIGHER_THAN_QUEUE_LENGTH);
+	}
+
+	unlinkNode(node);
+
+	// Positions start at 1, negative positions count back from the end so -1 is the last
+	uint32_t index = position > 0 ? position - 1 : context->renderQueueCount + 1 + position;
+	RenderQueue *next = context->renderQueue;
+	for (uint32_t i = 0; i < index && next != NULL; i++) {
+		next = next->pNext;
+	}
+	linkNode(context, node, next);
 
 	return SUCCESS;
 }
 
 void eng_windowChangeSize(Window *window, uint32_t width, uint32_t height, bool fullscreen) {
+	if (window == NULL || window->pWindow == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	if (!fullscreen && width > 0 && height > 0) {
+		SDL_SetWindowSize(window->pWindow, width, height);
+	}
 	SDL_SetWindowFullscreen(window->pWindow, fullscreen);
+	eng_updateWindowSize(window);
 }
 
 ENG_RESULT eng_moveToQueuePosition(void *data, int position) {
 	if (data == NULL) {
-		errorCode = DATA_IS_NULL;
-		if (debug) {
-			printf("ERROR: %s\n", eng_getError());
-		}
+		return eng_setError(DATA_IS_NULL);
 	}
 
-	if (position == 0) {
-		errorCode = POSITION_CANT_BE_ZERO;
-		if (debug) {
-			printf("ERROR: %s\n", eng_getError());
-		}
-		return errorCode;
+	RenderQueue *node = findNode(eng_getCurrentContext(), data);
+	if (node == NULL) {
+		return eng_setError(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE);
 	}
 
+	return moveNode(node, position);
+}
 
-	if (renderQueueCount == 1) {
-		return SUCCESS;
+ENG_RESULT eng_moveHandleToQueuePosition(eng_Handle handle, int position) {
+	RenderQueue *node = eng_getHandleNode(handle);
+	if (node == NULL) {
+		return eng_isHandleValid(handle) ? eng_setError(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE) : STALE_HANDLE;
 	}
 
-	if (abs(position) > renderQueueCount) {
-		errorCode = POSITION_HIGHER_THAN_QUEUE_LENGTH;
-		if (debug) {
-			printf("ERROR: %s\n", eng_getError());
-		}
-		return errorCode;
-	}
-
-	RenderQueue *object = getObjectFromPointer(data);
-	removeFromRenderQueueWithoutFreeing(data);
-	if (position == renderQueueCount || position == -1) {
-		object->pNext = NULL;
-		addQueueToRenderQueue(object);
-	} else {
-		RenderQueue *curr = renderQueue;
-		for (int i = 0; i < position-2; i++) {
-			curr = curr->pNext;
-		}
-
-		RenderQueue *prev = curr;
-		curr = curr->pNext;
-		object->pNext = curr;
-		prev->pNext = object;
+	if (node->pContext == NULL) {
+		return eng_setErrorDetail(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE, "Objects in a custom queue can't be moved to a position");
 	}
 
-	return SUCCESS;
+	return moveNode(node, position);
 }
 
 bool eng_isTouchingRects(eng_Rect firstRect, eng_Rect secondRect) {
@@ -179,7 +512,7 @@ bool eng_isTouching(float firstX, float firstY, float firstH, float firstW, floa
 eng_Rect *eng_createRect(uint32_t h, uint32_t w, uint32_t x, uint32_t y, eng_Color color) {
 	eng_Rect *rect = (eng_Rect *)malloc(sizeof(eng_Rect));
 	if (rect == NULL) {
-		errorCode = FAILED_TO_MALLOC;
+		eng_setError(FAILED_TO_MALLOC);
 		return NULL;
 	}
 	*rect = (eng_Rect) {
@@ -190,11 +523,14 @@ eng_Rect *eng_createRect(uint32_t h, uint32_t w, uint32_t x, uint32_t y, eng_Col
 	};
 	rect->color = (eng_Color *)malloc(sizeof(eng_Color));
 	if (rect->color == NULL) {
-		errorCode = FAILED_TO_MALLOC;
+		eng_setError(FAILED_TO_MALLOC);
 		free(rect);
 		return NULL;
 	}
 
+	eng_countAllocation();
+	eng_countAllocation();
+
 	*rect->color = (eng_Color) {
 		.r = color.r,
 		.g = color.g,
@@ -202,154 +538,200 @@ eng_Rect *eng_createRect(uint32_t h, uint32_t w, uint32_t x, uint32_t y, eng_Col
 		.a = color.a,
 	};
 
+	rect->handle = eng_createHandle(rect, TYPE_RECT);
+	if (rect->handle == ENG_INVALID_HANDLE) {
+		free(rect->color);
+		free(rect);
+		return NULL;
+	}
+
 	return rect;
 }
 
 ENG_RESULT eng_removeFromRenderQueue(void *data) {
-	RenderQueue *temp = renderQueue;
-	RenderQueue *prev = temp;
-	bool success = false;
-
-	if (temp->data == data) {
-		renderQueue = temp->pNext;
-		free(temp->data);
-		free(temp);
-
-		success = true;
-		renderQueueCount--;
-		if (debug)
-			printf("Removed from render queue\tCount: %d\n", renderQueueCount);
+	RenderQueue *node = data != NULL ? findNode(eng_getCurrentContext(), data) : NULL;
+	if (node == NULL) {
+		return eng_setError(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE);
 	}
 
-	while (temp != NULL && success == false) {
-		if (temp->data == data) {
-			prev->pNext = temp->pNext;
-			free(temp->data);
-			free(temp);
-
-			renderQueueCount--;
-			success = true;
-			if (debug)
-				printf("Removed from render queue\tCount: %d\n", renderQueueCount);
+	return removeNode(node);
+}
 
-			break;
-		}
-		prev = temp;
-		temp = temp->pNext;
+ENG_RESULT eng_removeHandle(eng_Handle handle) {
+	RenderQueue *node = eng_getHandleNode(handle);
+	if (node == NULL) {
+		return eng_isHandleValid(handle) ? eng_setError(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE) : STALE_HANDLE;
 	}
 
-	if (success != true) {
-		errorCode = FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
-		return FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
+	if (node->pContext == NULL) {
+		return eng_removeFromCustomRenderQueue(node->pHead != NULL ? node->pHead : node, node->data);
 	}
 
-	return SUCCESS;
+	return removeNode(node);
 }
 
 ENG_RESULT eng_removeFromCustomRenderQueue(RenderQueue *queue, void *data) {
+	if (queue == NULL) {
+		return eng_setError(QUEUE_WAS_NULL);
+	}
+
 	RenderQueue *temp = queue;
-	RenderQueue *prev = temp;
-	bool success = false;
+	while (temp != NULL && (temp->data != data || data == NULL)) {
+		temp = temp->pNext;
+	}
+	if (temp == NULL) {
+		return eng_setError(FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE);
+	}
+	destroyObject(temp->type, temp->data);
+
+	// The first node belongs to the caller, so the second node moves into it or it's left empty like eng_destroyCustomQueue leaves it
+	if (temp == queue) {
+		RenderQueue *next = queue->pNext;
+		if (next == NULL) {
+			*queue = (RenderQueue) {
+				.data = NULL,
+				.version = queue->version,
+			};
+		} else {
+			uint32_t version = queue->version;
+			*queue = *next;
+			queue->version = version;
+			queue->pPrev = NULL;
+			queue->pHead = NULL;
+			if (queue->pNext != NULL) {
+				queue->pNext->pPrev = queue;
+			}
+			eng_setHandleNode(getObjectHandle(queue->type, queue->data), queue);
+			freeNode(next);
+		}
+	} else {
+		temp->pPrev->pNext = temp->pNext;
+		if (temp->pNext != NULL) {
+			temp->pNext->pPrev = temp->pPrev;
+		}
+		freeNode(temp);
+	}
 
-	if (temp->data == data) {
-		queue = temp->pNext;
-		free(temp->data);
-		free(temp);
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_QUEUE, "Removed from custom render queue");
+	queue->version++;
 
-		success = true;
-		if (debug)
-			printf("Removed from custom render queue\n");
-	}
+	return SUCCESS;
+}
 
-	while (temp != NULL && success == false) {
-		if (temp->data == data) {
-			prev->pNext = temp->pNext;
-			free(temp->data);
-			free(temp);
+SDL_Texture *eng_loadTexture(SDL_Renderer *renderer, const char *path) {
+	size_t size;
+	void *data = SDL_LoadFile(path, &size);
+	if (data == NULL) {
+		eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "%s", path);
+		return NULL;
+	}
 
-			success = true;
-			if (debug)
-				printf("Removed from custom render queue\n");
+	SDL_Texture *texture = eng_loadCachedTexture(renderer, data, size);
+	if (texture != NULL) {
+		eng_addTextureMemory(texture);
+		eng_applyTextureFilter(texture);
+		SDL_free(data);
+		return texture;
+	}
 
-			break;
-		}
-		prev = temp;
-		temp = temp->pNext;
+	SDL_Surface *surface = IMG_Load_IO(SDL_IOFromConstMem(data, size), true);
+	SDL_free(data);
+	if (surface == NULL) {
+		eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to decode %s", path);
+		return NULL;
 	}
 
-	if (success != true) {
-		errorCode = FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
-		return FAILED_TO_REMOVE_RECT_FROM_RENDER_QUEUE;
+	texture = eng_createTextureFromSurface(renderer, surface);
+	SDL_DestroySurface(surface);
+	if (texture == NULL) {
+		eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to upload %s", path);
+		return NULL;
 	}
+	eng_applyTextureFilter(texture);
 
-	return SUCCESS;
+	return texture;
 }
 
-eng_Texture *eng_createImage(Window *pWindow, const char *path, uint32_t h, uint32_t w, uint32_t x, uint32_t y) {
+bool eng_loadImageSize(const char *path, int *w, int *h) {
 	SDL_Surface *surface = IMG_Load(path);
 	if (surface == NULL) {
-		errorCode = FAILED_TO_LOAD_IMAGE;
-		free(surface);
-		return NULL;
+		eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "Failed to decode %s", path);
+		return false;
 	}
 
-	SDL_Texture *newTexture = (SDL_Texture *)malloc(sizeof(SDL_Texture));
-	if (newTexture == NULL) {
-		errorCode = FAILED_TO_MALLOC;
-		free(surface);
-		return NULL;
-	}
-	newTexture = SDL_CreateTextureFromSurface(pWindow->pRenderer, surface);
+	*w = surface->w;
+	*h = surface->h;
 	SDL_DestroySurface(surface);
 
+	return true;
+}
+
+eng_Texture *eng_createImage(Window *pWindow, const char *path, uint32_t h, uint32_t w, uint32_t x, uint32_t y) {
+	// Simulations without a renderer keep the image's size and position but never load it
+	SDL_Texture *newTexture = NULL;
+	if (pWindow->pRenderer != NULL) {
+		newTexture = eng_acquireTexture(pWindow->pRenderer, path);
+		if (newTexture == NULL) {
+			return NULL;
+		}
+	}
+
 	eng_Texture *texture = (eng_Texture *)malloc(sizeof(eng_Texture));
 	if (texture == NULL) {
-		errorCode = FAILED_TO_MALLOC;
-		free(surface);
+		eng_setError(FAILED_TO_MALLOC);
+		eng_releaseTexture(newTexture);
 		return NULL;
 	}
+	eng_countAllocation();
 	*texture = (eng_Texture) {
 		.h = h,
 		.w = w,
 		.x = x,
 		.y = y,
 		.texture = newTexture,
+		.handle = eng_createHandle(texture, TYPE_TEXTURE),
 	};
+	if (texture->handle == ENG_INVALID_HANDLE) {
+		eng_releaseTexture(newTexture);
+		free(texture);
+		return NULL;
+	}
+	eng_trackAsset(path, TYPE_TEXTURE, texture, (eng_Color){0}, 0);
 
 	return texture;
 }
 
 ENG_RESULT eng_addObjectToRenderQueue(void *object, Type type) {
+	if (object == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
 	RenderQueue *newQueue = malloc(sizeof(RenderQueue));
+	if (newQueue == NULL) {
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+	eng_countAllocation();
+	eng_trackMemory(ENG_MEMORY_QUEUE, sizeof(RenderQueue), 1);
 	*newQueue = (RenderQueue) {
-		.pNext = NULL,
 		.data = object,
 		.type = type,
 	};
+	eng_Context *context = eng_getCurrentContext();
+	linkNode(context, newQueue, NULL);
+	eng_setHandleNode(getObjectHandle(type, object), newQueue);
 
-	if (renderQueueCount == 0) {
-		free(newQueue);
-		renderQueue->type = type;
-		renderQueue->data = object;
-	} else {
-		RenderQueue *temp = renderQueue;
-		while (temp->pNext != NULL) {
-			temp = temp->pNext;
-		}
-		temp->pNext = newQueue;
-	}
-
-	renderQueueCount++;
-	if (debug)
-		printf("Added to render queue\tCurrent count: %d\n", renderQueueCount);
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_QUEUE, "Added to render queue\tCurrent count: %d", context->renderQueueCount);
 
 	return SUCCESS;
-
-	return UNKNOWN_ERROR;
 }
 
 eng_Text *eng_createText(Window *window, const char *font, uint32_t fontSize, const char *text, eng_Color color, uint32_t x, uint32_t y) {
 	eng_Text *texture = (eng_Text *)malloc(sizeof(eng_Text));
+	if (texture == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+	eng_countAllocation();
 
 	SDL_Color selectedColor = (SDL_Color) {
 		.r = color.r,
@@ -358,25 +740,32 @@ eng_Text *eng_createText(Window *window, const char *font, uint32_t fontSize, co
 		.a = color.a,
 	};
 
-	TTF_Font *selectedFont = TTF_OpenFont(font, fontSize);
+	// The font stays open while the text uses it and is shared with every text of the same font and size
+	TTF_Font *selectedFont = eng_acquireFont(font, fontSize);
 	if (selectedFont == NULL) {
-		errorCode = FAILED_TO_OPEN_FONT;
 		free(texture);
 		return NULL;
 	}
-	SDL_Surface *fontSurface = TTF_RenderText_Blended(selectedFont, text, strlen(text), selectedColor);
-	if (fontSurface == NULL) {
-		errorCode = FAILED_TO_CREATE_FONT_RENDER;
-		free(texture);
-		return NULL;
-	}
-	SDL_Texture *fontTexture = SDL_CreateTextureFromSurface(window->pRenderer, fontSurface);
-	if (texture == NULL) {
-		errorCode = FAILED_TO_CONVERT_FONT_TO_TEXTURE;
-		free(texture);
-		return NULL;
+
+	// Without a renderer the text is only measured so simulations still get its size
+	SDL_Texture *fontTexture = NULL;
+	if (window->pRenderer != NULL) {
+		SDL_Surface *fontSurface = TTF_RenderText_Blended(selectedFont, text, strlen(text), selectedColor);
+		if (fontSurface == NULL) {
+			eng_setErrorDetail(FAILED_TO_CREATE_FONT_RENDER, "%s", text);
+			eng_releaseFont(selectedFont);
+			free(texture);
+			return NULL;
+		}
+		fontTexture = eng_createTextureFromSurface(window->pRenderer, fontSurface);
+		SDL_DestroySurface(fontSurface);
+		if (fontTexture == NULL) {
+			eng_setErrorDetail(FAILED_TO_CONVERT_FONT_TO_TEXTURE, "%s", text);
+			eng_releaseFont(selectedFont);
+			free(texture);
+			return NULL;
+		}
 	}
-	SDL_DestroySurface(fontSurface);
 
 	TTF_Text *textPointer = TTF_CreateText(NULL, selectedFont, text, 0);
 	int h, w;
@@ -389,48 +778,159 @@ eng_Text *eng_createText(Window *window, const char *font, uint32_t fontSize, co
 		.x = x,
 		.y = y,
 		.text = textPointer,
+		.handle = eng_createHandle(texture, TYPE_TEXT),
 	};
+	if (texture->handle == ENG_INVALID_HANDLE) {
+		eng_destroyTexture(fontTexture);
+		TTF_DestroyText(textPointer);
+		eng_releaseFont(selectedFont);
+		free(texture);
+		return NULL;
+	}
+	eng_trackAsset(font, TYPE_TEXT, texture, color, fontSize);
 
 	return texture;
 }
 
-ENG_RESULT eng_init(bool debugEnabled) {
+static ENG_RESULT init(bool debugEnabled, SDL_InitFlags flags) {
 	debug = debugEnabled;
-	renderQueue = (RenderQueue *)malloc(sizeof(RenderQueue));
-	renderQueue->pNext = NULL;
-	renderQueue->data = NULL;
-
-	if (!SDL_Init(SDL_INIT_VIDEO) || !TTF_Init()) {
-		return errorCode = FAILED_TO_INIT_SDL;
-	}
 	if (debug) {
-		printf("Successfully initialized SDL\n");
+		eng_setLogLevel(ENG_LOG_DEBUG);
+		eng_startLogging(NULL);
 	}
 
+	if (!SDL_Init(flags) || !TTF_Init()) {
+		return eng_setError(FAILED_TO_INIT_SDL);
+	}
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Successfully initialized SDL");
+
 	return SUCCESS;
 }
 
+ENG_RESULT eng_init(bool debugEnabled) {
+	return init(debugEnabled, SDL_INIT_VIDEO);
+}
+
+ENG_RESULT eng_initHeadless(bool debugEnabled) {
+	// The software renderer and fonts don't need a display so servers without one can still run simulations
+	return init(debugEnabled, 0);
+}
+
+static bool translateEvent(Application *app, SDL_Event *event);
+
+static void pushPendingEvent(eng_Context *context, SDL_Event *event) {
+	// A window nobody polls keeps its newest events
+	if (context->pendingCount == PENDING_EVENTS) {
+		context->pendingStart = (context->pendingStart + 1) % PENDING_EVENTS;
+		context->pendingCount--;
+	}
+
+	context->pending[(context->pendingStart + context->pendingCount) % PENDING_EVENTS] = *event;
+	context->pendingCount++;
+}
+
+static eng_Context *findEventContext(SDL_Event *event) {
+	SDL_Window *window = SDL_GetWindowFromEvent(event);
+	if (window == NULL) {
+		return NULL;
+	}
+
+	for (eng_Context *context = &mainContext; context != NULL; context = context->pNextContext) {
+		if (context->window != NULL && context->window->pWindow == window) {
+			return context;
+		}
+	}
+
+	return NULL;
+}
+
+// SDL has one event queue for every window, events for another application's window are kept until that application polls
+static bool nextEvent(eng_Context *context) {
+	if (context->pendingCount > 0) {
+		context->event = context->pending[context->pendingStart];
+		context->pendingStart = (context->pendingStart + 1) % PENDING_EVENTS;
+		context->pendingCount--;
+		return true;
+	}
+
+	// Headless applications other than the first have no window, they only get what was handed to them
+	if (context != &mainContext && (context->window == NULL || context->window->pWindow == NULL)) {
+		return false;
+	}
+
+	while (SDL_PollEvent(&context->event)) {
+		if (context->event.type == SDL_EVENT_QUIT) {
+			for (eng_Context *other = &mainContext; other != NULL; other = other->pNextContext) {
+				if (other != context && other->window != NULL) {
+					pushPendingEvent(other, &context->event);
+				}
+			}
+			return true;
+		}
+
+		eng_Context *owner = findEventContext(&context->event);
+		if (owner == NULL || owner == context) {
+			return true;
+		}
+		pushPendingEvent(owner, &context->event);
+	}
+
+	return false;
+}
+
 bool eng_pollEvent(Application *app, uint32_t fps) {
-	SDL_PollEvent(&e);
+	bool result;
+	if (eng_replayPollEvent(app, &result)) {
+		return result;
+	}
+
+	eng_Context *context = app->context;
+	if (context->simulated || !nextEvent(context)) {
+		context->event.type = SDL_EVENT_FIRST;
+	}
 
-	if (fps > 0) {
-		nsPerFrame = 1000000000 / fps;
-		if (renderingNS - endingNS < nsPerFrame) {
-			uint32_t sleepTime = nsPerFrame - (endingNS - renderingNS);
+	// Simulations run as fast as they can
+	if (fps > 0 && !context->simulated) {
+		context->nsPerFrame = 1000000000 / fps;
+		uint64_t elapsedNS = context->renderingNS > context->endingNS ? context->renderingNS - context->endingNS : 0;
+		if (elapsedNS < context->nsPerFrame) {
+			uint64_t sleepTime = context->nsPerFrame - elapsedNS;
 			SDL_DelayNS(sleepTime);
+			context->sleptNS += sleepTime;
 
-			endingNS = SDL_GetTicksNS();
+			context->endingNS = SDL_GetTicksNS();
 		} else {
-			endingNS = SDL_GetTicksNS();
+			context->endingNS = SDL_GetTicksNS();
 		}
 	}
 
-	if (e.type == SDL_EVENT_QUIT) {
+	result = translateEvent(app, &context->event);
+	eng_recordPoll(app, result);
+	if (result) {
+		eng_countEvent();
+	}
+
+	return result;
+}
+
+// Mouse events carry the position in the window they happened in, so each application gets its own window's coordinates
+static Mouse getEventMouse(Window *window, float x, float y) {
+	Mouse mouse = (Mouse) {
+		.x = x,
+		.y = y,
+	};
+	eng_windowToVirtual(window, &mouse.x, &mouse.y);
+
+	return mouse;
+}
+
+static bool translateEvent(Application *app, SDL_Event *event) {
+	if (event->type == SDL_EVENT_QUIT || event->type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
 		app->isRunning = false;
 		return false;
-	} else if (e.type == SDL_EVENT_KEY_DOWN) {
+	} else if (event->type == SDL_EVENT_KEY_DOWN) {
 		app->event.type = ENG_EVENT_KEY_DOWN;
-		switch(e.key.scancode) {
+		switch(event->key.scancode) {
 			case SDL_SCANCODE_ESCAPE:
 				app->event.value = ENG_KEY_ESC;
 				break;
@@ -548,9 +1048,9 @@ bool eng_pollEvent(Application *app, uint32_t fps) {
 				break;
 		}
 		return true;
-	} else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
-		app->event.type = ENG_MOUSE_BUTTON;
-		switch(e.button.button) {
+	} else if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN || event->type == SDL_EVENT_MOUSE_BUTTON_UP) {
+		app->event.type = event->type == SDL_EVENT_MOUSE_BUTTON_DOWN ? ENG_MOUSE_BUTTON : ENG_MOUSE_BUTTON_UP;
+		switch(event->button.button) {
 			case SDL_BUTTON_LEFT:
 				app->event.value = MOUSE_BUTTON_LEFT;
 				break;
@@ -561,16 +1061,18 @@ bool eng_pollEvent(Application *app, uint32_t fps) {
 				app->event.value = MOUSE_BUTTON_RIGHT;
 				break;
 		}
-	} else if (e.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
-		SDL_GetWindowSize(app->window->pWindow, &app->window->width, &app->window->height);
+		app->mouse = getEventMouse(app->window, event->button.x, event->button.y);
 		return true;
-	} else if (e.type == SDL_EVENT_WINDOW_RESIZED) {
+	} else if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+		eng_updateWindowSize(app->window);
+		return true;
+	} else if (event->type == SDL_EVENT_WINDOW_RESIZED) {
 		app->event.type = ENG_EVENT_WINDOW_SIZE_CHANGED;
-		SDL_GetWindowSize(app->window->pWindow, &app->window->width, &app->window->height);
+		eng_updateWindowSize(app->window);
 		return true;
-	} else if (e.type == SDL_EVENT_MOUSE_MOTION) {
+	} else if (event->type == SDL_EVENT_MOUSE_MOTION) {
 		app->event.type = ENG_EVENT_MOUSE_MOTION;
-		app->mouse = eng_getMousePosition();
+		app->mouse = getEventMouse(app->window, event->motion.x, event->motion.y);
 		return true;
 	}
 
@@ -580,7 +1082,12 @@ bool eng_pollEvent(Application *app, uint32_t fps) {
 Mouse eng_getMousePosition() {
 	Mouse mouse;
 
+	// The position is relative to the focused window, it's only virtual when that's the current context's window
 	SDL_GetMouseState(&mouse.x, &mouse.y);
+	Window *window = eng_getCurrentContext()->window;
+	if (window != NULL && window->pWindow != NULL && window->pWindow == SDL_GetMouseFocus()) {
+		eng_windowToVirtual(window, &mouse.x, &mouse.y);
+	}
 
 	return mouse;
 }
@@ -588,56 +1095,88 @@ Mouse eng_getMousePosition() {
 void eng_centerText(Window *pWindow, eng_Text *text) {
 	text->x = (float)(pWindow->width - text->w) / 2;
 	text->y = (float)(pWindow->height - text->h) / 2;
+	eng_markObjectMoved(text->handle);
 }
 
-void eng_render(Application *app, eng_Color backgroundColor) {
-	renderingNS = SDL_GetTicksNS();
+void eng_drawRenderQueue(Application *app, eng_Color backgroundColor) {
+	if (app->context == &mainContext) {
+		eng_applyHotReload();
+	}
 
 	SDL_SetRenderDrawColor(app->window->pRenderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
 	SDL_RenderClear(app->window->pRenderer);
 
-	if (renderQueue != NULL) {
-		RenderQueue *temp = renderQueue;
+	if (app->context->renderQueue != NULL) {
+		RenderQueue *temp = app->context->renderQueue;
 		while (temp != NULL) {
-			if (temp->type == TYPE_RECT) {
-				eng_Rect *rect = temp->data;
-				SDL_FRect frect = (SDL_FRect) {
-					.h = rect->h,
-					.w = rect->w,
-					.x = rect->x,
-					.y = rect->y,
-				};
-
-				SDL_SetRenderDrawColor(app->window->pRenderer, rect->color->r, rect->color->g,rect->color->b, rect->color->a);
-				SDL_RenderFillRect(app->window->pRenderer, &frect);
-			} else if (temp->type == TYPE_TEXTURE) {
-				eng_Texture *texture = temp->data;
-				SDL_FRect rect = (SDL_FRect) {
-					.h = texture->h,
-					.w = texture->w,
-					.x = texture->x,
-					.y = texture->y,
-				};
-				SDL_RenderTexture(app->window->pRenderer, texture->texture, NULL, &rect);
-			} else if (temp->type == TYPE_TEXT) {
-				eng_Text *text = temp->data;
-				SDL_FRect rect = (SDL_FRect) {
-					.h = text->h,
-					.w = text->w,
-					.x = text->x,
-					.y = text->y,
-				};
-				SDL_RenderTexture(app->window->pRenderer, text->texture, NULL, &rect);
-			}
+			renderObject(app->window->pRenderer, temp->type, temp->data);
 			temp = temp->pNext;
 		}
 	}
+}
+
+bool eng_isRenderedFrame(Application *app) {
+	eng_Context *context = app->context;
+	if (!context->simulated) {
+		return true;
+	}
+
+	return context->renderEvery > 0 && app->window->pRenderer != NULL && (context->frame + 1) % context->renderEvery == 0;
+}
+
+// Simulations never present, a sampled frame is left in the window's surface for eng_captureFrame or saving
+static bool skipSimulatedFrame(Application *app) {
+	eng_Context *context = app->context;
+	if (!context->simulated) {
+		return false;
+	}
+
+	bool rendered = eng_isRenderedFrame(app);
+	context->frame++;
+
+	// Keeps the frame times in eng_getStats going for frames that aren't drawn
+	if (!rendered && context == &mainContext) {
+		eng_finishFrame(context->renderQueueCount);
+	}
+
+	return !rendered;
+}
+
+void eng_render(Application *app, eng_Color backgroundColor) {
+	if (skipSimulatedFrame(app)) {
+		return;
+	}
+
+	eng_Context *context = app->context;
+	context->renderingNS = SDL_GetTicksNS();
+
+	// Scaling, post-processing and the HUD belong to the first application, the others draw straight to their renderer
+	bool isMain = context == &mainContext;
+	if (isMain) {
+		eng_beginPostProcess(app->window);
+		eng_beginScaledFrame(app->window);
+	}
+	eng_drawRenderQueue(app, backgroundColor);
+	if (isMain) {
+		eng_endScaledFrame(app->window);
+		eng_endPostProcess(app->window);
+		eng_renderHud(app->window->pRenderer);
+		eng_finishFrame(context->renderQueueCount);
+	}
 	
 	SDL_RenderPresent(app->window->pRenderer);
+	if (isMain) {
+		eng_updateRenderScale(context->sleptNS);
+	}
+	context->sleptNS = 0;
 }
 
 const char *eng_getError() {
-	switch (errorCode) {
+	return getErrorMessage(getErrorState()->code);
+}
+
+static const char *getErrorMessage(ENG_RESULT code) {
+	switch (code) {
 		case SUCCESS:
 			return "There was no error";
 		case FAILED_TO_CREATE_RENDERER:
@@ -667,9 +1206,51 @@ const char *eng_getError() {
 		case FAILED_TO_CONVERT_FONT_TO_TEXTURE:
 			return "Failed to convert font to a texture";
 		case INVALID_TYPE:
-			return "Cannot provide TYPE_UNKNOWN to function";
+			return "Cannot provide that type to function";
 		case QUEUE_WAS_NULL:
 			return "The queue provided was NULL";
+		case FAILED_TO_OPEN_SCENE:
+			return "Failed to open the scene file, check the location of the file";
+		case INVALID_SCENE_FORMAT:
+			return "The scene file is corrupt or was written by a different version of the engine";
+		case FAILED_TO_WRITE_SCENE:
+			return "Failed to write the scene file";
+		case FAILED_TO_WRITE_TEXTURE_CACHE:
+			return "Failed to write the cooked texture, check the cache directory exists";
+		case FAILED_TO_START_THREAD:
+			return "Failed to start a background thread";
+		case FAILED_TO_CAPTURE_FRAME:
+			return "Failed to read the pixels back from the renderer";
+		case FRAME_SIZE_MISMATCH:
+			return "The captured frame and the golden image are different sizes";
+		case FAILED_TO_OPEN_REPLAY:
+			return "Failed to open the replay file";
+		case INVALID_REPLAY_FORMAT:
+			return "The replay file is corrupt or was written by a different version of the engine";
+		case STALE_HANDLE:
+			return "The handle points to an object that was already removed";
+		case OUT_OF_HANDLES:
+			return "Every handle is in use";
+		case INVALID_TRANSFORM_PARENT:
+			return "The parent doesn't exist or is a child of the node";
+		case FAILED_TO_SET_PRESENTATION:
+			return "Failed to set the virtual resolution or render scale";
+		case FAILED_TO_INIT_AUDIO:
+			return "Failed to open the audio device";
+		case FAILED_TO_LOAD_SOUND:
+			return "Failed to load the sound, only WAV files are supported";
+		case INVALID_WORLD_SIZE:
+			return "A world needs at least one chunk and a chunk size above 0";
+		case INVALID_CHUNK_PATH:
+			return "A chunk path format needs exactly two %u, for the column and the row, and no other conversions";
+		case MISSING_GOLDEN_IMAGE:
+			return "The golden image doesn't exist, run the check with recording on to save the frame as the golden image";
+		case SPRITE_OUTSIDE_SHEET:
+			return "The sprite's column or row is outside the sprite sheet";
+		case INVALID_POST_PASS:
+			return "The post-process pass doesn't exist or there's no room for another";
+		case FAILED_TO_OPEN_LOG:
+			return "Failed to open the log file";
 		case UNKNOWN_ERROR:
 			return "The error is unknown, this shouldn't be possible";
 	}
@@ -677,151 +1258,409 @@ const char *eng_getError() {
 	return "Failed to find error";
 }
 
+// The first application gets the main context so objects added to the render queue before it was made still show up
+static bool attachContext(Application *app) {
+	eng_Context *context = &mainContext;
+	if (mainContext.window != NULL) {
+		context = (eng_Context *)calloc(1, sizeof(eng_Context));
+		if (context == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			return false;
+		}
+		context->pNextContext = mainContext.pNextContext;
+		mainContext.pNextContext = context;
+	}
+
+	context->window = app->window;
+	app->context = context;
+
+	return true;
+}
+
+static void destroyQueue(eng_Context *context) {
+	if (context->renderQueue == NULL) {
+		return;
+	}
+
+	uint32_t freed = 0;
+	RenderQueue *temp = context->renderQueue;
+	RenderQueue *prev = temp;
+	while (temp != NULL) {
+		prev = temp;
+		temp = temp->pNext;
+
+		destroyObject(prev->type, prev->data);
+
+		freeNode(prev);
+		freed++;
+	}
+	context->renderQueue = NULL;
+	context->renderQueueTail = NULL;
+	context->renderQueueCount = 0;
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_QUEUE, "Freed %u queue positions", freed);
+}
+
+// Objects in custom queues or never queued still hold textures from the context's renderer, so they go before it does
+static void destroyContextObjects(eng_Context *context) {
+	uint32_t cursor = 0;
+	uint32_t destroyed = 0;
+	Type type;
+	void *object;
+	while ((object = eng_nextLiveObject(context, &cursor, &type)) != NULL) {
+		eng_Handle handle = getObjectHandle(type, object);
+		if (eng_getHandleNode(handle) != NULL) {
+			eng_removeHandle(handle);
+		} else {
+			destroyObject(type, object);
+		}
+		destroyed++;
+	}
+
+	if (destroyed > 0) {
+		eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Destroyed %u objects outside the render queue", destroyed);
+	}
+}
+
+static void destroyWindow(Window *window) {
+	if (window->pRenderer) {
+		eng_destroyRendererTextures(window->pRenderer);
+		SDL_DestroyRenderer(window->pRenderer);
+	}
+	if (window->pWindow) {
+		SDL_DestroyWindow(window->pWindow);
+	}
+	if (window->pSurface) {
+		SDL_DestroySurface(window->pSurface);
+	}
+}
+
+static void detachContext(eng_Context *context) {
+	if (SDL_GetTLS(&currentContext) == context) {
+		eng_setCurrentContext(NULL);
+	}
+
+	if (context == &mainContext) {
+		eng_Context *next = mainContext.pNextContext;
+		mainContext = (eng_Context) {
+			.pNextContext = next,
+		};
+		return;
+	}
+
+	for (eng_Context *prev = &mainContext; prev != NULL; prev = prev->pNextContext) {
+		if (prev->pNextContext == context) {
+			prev->pNextContext = context->pNextContext;
+			break;
+		}
+	}
+	free(context);
+}
+
 Application *eng_createApplication(const char *title, const uint32_t width, const uint32_t height) {
 	Application *app = (Application *)malloc(sizeof(Application));
 	app->isRunning = true;
 
 	app->window = malloc(sizeof(Window));
+	app->window->pSurface = NULL;
 	app->window->pWindow = SDL_CreateWindow(title, width, height, SDL_WINDOW_RESIZABLE);
 	if (app->window->pWindow == NULL) {
-		errorCode = FAILED_TO_CREATE_WINDOW;
+		eng_setError(FAILED_TO_CREATE_WINDOW);
 		free(app);
 		return NULL;
 	}
-	if (debug) {
-		printf("Created Window\n");
-	}
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Created Window");
 
 	SDL_GetWindowSize(app->window->pWindow, &app->window->width, &app->window->height);
 
 	app->window->pRenderer = SDL_CreateRenderer(app->window->pWindow, NULL);
 	if (app->window->pRenderer == NULL) {
-		errorCode = FAILED_TO_CREATE_RENDERER;
+		eng_setError(FAILED_TO_CREATE_RENDERER);
 		SDL_DestroyWindow(app->window->pWindow);
 		free(app);
 		return NULL;
 	}
-	if (debug) {
-		printf("Created Renderer\n");
-	}
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Created Renderer");
 
-	if (debug) {
-		printf("Created Application\n\n\n");
+	if (!attachContext(app)) {
+		destroyWindow(app->window);
+		free(app->window);
+		free(app);
+		return NULL;
 	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Created Application");
 	return app;
 }
 
-void eng_quit(Application *app) {
-	if (renderQueue != NULL) {
-		int i = 1;
-		RenderQueue *temp = renderQueue;
-		RenderQueue *prev = temp;
-		while (temp != NULL) {
-			prev = temp;
-			temp = temp->pNext;
+Application *eng_createHeadlessApplication(const uint32_t width, const uint32_t height) {
+	Application *app = (Application *)calloc(1, sizeof(Application));
+	if (app == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+	app->isRunning = true;
 
-			if (prev->type == TYPE_RECT) {
-				eng_Rect *rect = prev->data;
-				free(rect->color);
-				free(rect);
-			} else if (prev->type == TYPE_TEXTURE) {
-				eng_Texture *texture = prev->data;
-				SDL_DestroyTexture(texture->texture);
-				free(texture);
-			}
+	app->window = calloc(1, sizeof(Window));
+	if (app->window == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		free(app);
+		return NULL;
+	}
+
+	app->window->pSurface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+	if (app->window->pSurface == NULL) {
+		eng_setError(FAILED_TO_CREATE_WINDOW);
+		free(app->window);
+		free(app);
+		return NULL;
+	}
+	app->window->width = width;
+	app->window->height = height;
+
+	app->window->pRenderer = SDL_CreateSoftwareRenderer(app->window->pSurface);
+	if (app->window->pRenderer == NULL) {
+		eng_setError(FAILED_TO_CREATE_RENDERER);
+		SDL_DestroySurface(app->window->pSurface);
+		free(app->window);
+		free(app);
+		return NULL;
+	}
 
-			free(prev);
-		if (debug) {
-			printf("Freed queue position %d of %d\n", i, renderQueueCount);
-			i++;
+	if (!attachContext(app)) {
+		destroyWindow(app->window);
+		free(app->window);
+		free(app);
+		return NULL;
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Created headless Application");
+	return app;
+}
+
+Application *eng_createSimulation(const uint32_t width, const uint32_t height, uint32_t renderEvery) {
+	Application *app;
+	if (renderEvery > 0) {
+		app = eng_createHeadlessApplication(width, height);
+		if (app == NULL) {
+			return NULL;
 		}
+	} else {
+		app = (Application *)calloc(1, sizeof(Application));
+		if (app == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			return NULL;
+		}
+		app->isRunning = true;
+
+		app->window = calloc(1, sizeof(Window));
+		if (app->window == NULL || !attachContext(app)) {
+			eng_setError(FAILED_TO_MALLOC);
+			free(app->window);
+			free(app);
+			return NULL;
+		}
+		app->window->width = width;
+		app->window->height = height;
+	}
+
+	app->context->simulated = true;
+	app->context->renderEvery = renderEvery;
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Created simulation\tRendering every %u frames", renderEvery);
+
+	return app;
+}
+
+static const char *getTypeName(Type type) {
+	switch (type) {
+		case TYPE_RECT:
+			return "rect";
+		case TYPE_TEXTURE:
+			return "image";
+		case TYPE_TEXT:
+			return "text";
+		default:
+			return "object";
+	}
+}
+
+// Objects that were made but never removed or put in the main queue are still in the handle table
+static void destroyLeakedObjects() {
+	uint32_t cursor = 0;
+	uint32_t leaked = 0;
+	Type type;
+	void *object;
+	while ((object = eng_nextLiveObject(NULL, &cursor, &type)) != NULL) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "Leaked %s at %p, it was never removed", getTypeName(type), object);
+		destroyObject(type, object);
+		leaked++;
+	}
+
+	if (leaked > 0) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "Destroyed %u leaked objects", leaked);
+	}
+}
+
+void eng_quit(Application *app) {
+	eng_disableHotReload();
+	eng_stopRecording();
+	eng_stopReplay();
+	eng_destroyHud();
+	eng_destroyPresent();
+	eng_clearPostPasses();
+	eng_quitAudio();
+
+	for (eng_Context *context = &mainContext; context != NULL; context = context->pNextContext) {
+		destroyQueue(context);
+	}
+	destroyLeakedObjects();
+	eng_destroyHandles();
+	eng_destroyMemoryCaches();
+
+	while (mainContext.pNextContext != NULL) {
+		eng_Context *context = mainContext.pNextContext;
+		if (app == NULL || context != app->context) {
+			eng_log(ENG_LOG_WARN, ENG_LOG_CORE, "An application was never destroyed, its window is closed now");
+			destroyWindow(context->window);
+			free(context->window);
 		}
+		detachContext(context);
 	}
 
 	if (app) {
-		SDL_DestroyRenderer(app->window->pRenderer);
-		SDL_DestroyWindow(app->window->pWindow);
+		destroyWindow(app->window);
 	}
+	detachContext(&mainContext);
+
+	eng_reportMemory();
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Shut down");
+	eng_stopLogging();
 
 	TTF_Quit();
 	SDL_Quit();
 }
 
+void eng_destroyApplication(Application *app) {
+	if (app == NULL) {
+		return;
+	}
+
+	// Hot reload, presentation and post-processing belong to the first application and hold its window and renderer
+	if (app->context == &mainContext) {
+		eng_disableHotReload();
+		eng_destroyPresent();
+		eng_clearPostPasses();
+	}
+
+	destroyQueue(app->context);
+	destroyContextObjects(app->context);
+	detachContext(app->context);
+	destroyWindow(app->window);
+	free(app->window);
+	free(app);
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_CORE, "Destroyed Application");
+}
+
 ENG_RESULT eng_addToCustomQueue(RenderQueue *queue, void *object, Type type) {
 	if (type == TYPE_UNKNOWN) {
-		return errorCode = INVALID_TYPE;
+		return eng_setError(INVALID_TYPE);
 	}
 
 	if (queue == NULL) {
-		return errorCode = QUEUE_WAS_NULL;
+		return eng_setError(QUEUE_WAS_NULL);
 	}
 
 	if (queue->data == NULL) {
 		queue->data = object;
 		queue->pNext = NULL;
+		queue->pPrev = NULL;
 		queue->type = type;
+		queue->pContext = NULL;
+		queue->pHead = NULL;
+		eng_setHandleNode(getObjectHandle(type, object), queue);
+		queue->version++;
+		return SUCCESS;
 	}
 
 	RenderQueue *newQueue = (RenderQueue *)malloc(sizeof(RenderQueue));
 	if (newQueue == NULL) {
-		return  errorCode = FAILED_TO_MALLOC;
+		return eng_setError(FAILED_TO_MALLOC);
 	}
+	eng_countAllocation();
+	eng_trackMemory(ENG_MEMORY_QUEUE, sizeof(RenderQueue), 1);
 
 	*newQueue = (RenderQueue) {
 		.pNext = NULL,
 		.type = type,
 		.data = object,
+		.pHead = queue,
 	};
-	
+	eng_setHandleNode(getObjectHandle(type, object), newQueue);
+
 	RenderQueue *curr = queue;
 	while (curr->pNext != NULL) {
 		curr = curr->pNext;
 	}
 	curr->pNext = newQueue;
+	newQueue->pPrev = curr;
+	queue->version++;
+
+	return SUCCESS;
+}
+
+void eng_destroyCustomQueue(RenderQueue *queue) {
+	if (queue == NULL) {
+		return;
+	}
 
-	return errorCode = SUCCESS;
+	RenderQueue *node = queue->pNext;
+	while (node != NULL) {
+		RenderQueue *next = node->pNext;
+		destroyObject(node->type, node->data);
+		freeNode(node);
+		node = next;
+	}
+
+	destroyObject(queue->type, queue->data);
+	*queue = (RenderQueue) {
+		.data = NULL,
+		.version = queue->version + 1,
+	};
 }
 
 ENG_RESULT eng_renderCustomQueue(Application *app, RenderQueue *customQueue, eng_Color backgroundColor) {
-	renderingNS = SDL_GetTicksNS();
+	if (skipSimulatedFrame(app)) {
+		return SUCCESS;
+	}
+
+	eng_Context *context = app->context;
+	context->renderingNS = SDL_GetTicksNS();
+
+	bool isMain = context == &mainContext;
+	if (isMain) {
+		eng_applyHotReload();
+		eng_beginPostProcess(app->window);
+		eng_beginScaledFrame(app->window);
+	}
 
 	RenderQueue *curr = customQueue;
 	SDL_SetRenderDrawColor(app->window->pRenderer, 0, 0, 0, 255);
 	SDL_RenderClear(app->window->pRenderer);
 	while (curr != NULL) {
-		if (curr->type == TYPE_RECT) {
-			eng_Rect *rect = curr->data;
-			SDL_FRect frect = (SDL_FRect) {
-				.h = rect->h,
-				.w = rect->w,
-				.x = rect->x,
-				.y = rect->y,
-			};
-			SDL_RenderFillRect(app->window->pRenderer, &frect);
-		} else if (curr->type == TYPE_TEXTURE) {
-			eng_Texture *texture = curr->data;
-			SDL_FRect rect = (SDL_FRect) {
-				.h = texture->h,
-				.w = texture->w,
-				.x = texture->x,
-				.y = texture->y,
-			};
-			SDL_RenderTexture(app->window->pRenderer, texture->texture, NULL, &rect);
-		} else if (curr->type == TYPE_TEXT) {
-			eng_Text *text = curr->data;
-			SDL_FRect rect = (SDL_FRect) {
-				.h = text->h,
-				.w = text->w,
-				.x = text->x,
-				.y = text->y,
-			};
-			SDL_RenderTexture(app->window->pRenderer, text->texture, NULL, &rect);
-		}
-
+		renderObject(app->window->pRenderer, curr->type, curr->data);
 		curr = curr->pNext;
 	}
+	if (isMain) {
+		eng_endScaledFrame(app->window);
+		eng_endPostProcess(app->window);
+		eng_renderHud(app->window->pRenderer);
+		eng_finishFrame(context->renderQueueCount);
+	}
 
 	SDL_RenderPresent(app->window->pRenderer);
+	if (isMain) {
+		eng_updateRenderScale(context->sleptNS);
+	}
+	context->sleptNS = 0;
 
 	return SUCCESS;
 }
@@ -836,7 +1675,12 @@ eng_Rect eng_extractRectFromObject(void *object, Type type) {
 
 	switch (type) {
 		case TYPE_UNKNOWN:
-			errorCode = INVALID_TYPE;
+		case TYPE_SCENE:
+		case TYPE_RECT_BATCH:
+		case TYPE_SPRITE_BATCH:
+		case TYPE_UI:
+		case TYPE_WORLD:
+			eng_setError(INVALID_TYPE);
 			return rect;
 		case TYPE_RECT: ;
 			eng_Rect *passedRect = object;
@@ -22,6 +22,27 @@ typedef enum {
 	FAILED_TO_CONVERT_FONT_TO_TEXTURE,
 	INVALID_TYPE,
 	QUEUE_WAS_NULL,
+	FAILED_TO_OPEN_SCENE,
+	INVALID_SCENE_FORMAT,
+	FAILED_TO_WRITE_SCENE,
+	FAILED_TO_WRITE_TEXTURE_CACHE,
+	FAILED_TO_START_THREAD,
+	FAILED_TO_CAPTURE_FRAME,
+	FRAME_SIZE_MISMATCH,
+	FAILED_TO_OPEN_REPLAY,
+	INVALID_REPLAY_FORMAT,
+	FAILED_TO_OPEN_LOG,
+	STALE_HANDLE,
+	OUT_OF_HANDLES,
+	INVALID_TRANSFORM_PARENT,
+	FAILED_TO_SET_PRESENTATION,
+	FAILED_TO_INIT_AUDIO,
+	FAILED_TO_LOAD_SOUND,
+	INVALID_WORLD_SIZE,
+	INVALID_POST_PASS,
+	INVALID_CHUNK_PATH,
+	MISSING_GOLDEN_IMAGE,
+	SPRITE_OUTSIDE_SHEET,
 	UNKNOWN_ERROR,
 } ENG_RESULT;
 
@@ -30,12 +51,37 @@ typedef enum {
 	TYPE_RECT,
 	TYPE_TEXTURE,
 	TYPE_TEXT,
+	TYPE_SCENE,
+	TYPE_RECT_BATCH,
+	TYPE_SPRITE_BATCH,
+	TYPE_UI,
+	TYPE_WORLD,
 } Type;
 
+#define ENG_ERROR_DETAIL_LENGTH 256
+
+/*
+* Called on the thread that hit the error, message is the same string eng_getError returns and detail may be empty
+*/
+typedef void (*eng_ErrorCallback)(ENG_RESULT code, const char *message, const char *detail);
+
+/*
+* Identifies an object made by eng_createRect, eng_createImage or eng_createText, see handle.h
+*/
+typedef uint32_t eng_Handle;
+
+#define ENG_INVALID_HANDLE 0
+
+typedef struct eng_Context eng_Context;
+
 typedef struct RenderQueue {
 	struct RenderQueue *pNext;
+	struct RenderQueue *pPrev;
 	Type type;
 	void *data;
+	eng_Context *pContext; // The context whose render queue holds the node, NULL in custom queues
+	struct RenderQueue *pHead; // First node of the custom queue holding the node, NULL for the first node and in render queues
+	uint32_t version; // Goes up when the custom queue's layout changes, only kept on its first node
 } RenderQueue;
 
 typedef struct {
@@ -51,6 +97,7 @@ typedef struct {
 	float x;
 	float y;
 	eng_Color *color;
+	eng_Handle handle;
 } eng_Rect;
 
 typedef enum {
@@ -60,6 +107,7 @@ typedef enum {
 	ENG_MOUSE_BUTTON,
 	ENG_EVENT_WINDOW_SIZE_CHANGED,
 	ENG_EVENT_MOUSE_MOTION,
+	ENG_MOUSE_BUTTON_UP, // Added after the others so recorded replays keep their event types
 } ENG_TYPE;
 
 typedef enum {
@@ -123,6 +171,7 @@ typedef struct {
 typedef struct {
 	SDL_Window *pWindow;
 	SDL_Renderer *pRenderer;
+	SDL_Surface *pSurface;
 	int width;
 	int height;
 	SDL_Texture background;
@@ -134,6 +183,7 @@ typedef struct {
 	Event event;
 	Mouse mouse;
 	TTF_Font *font;
+	eng_Context *context; // Owns the render queue, events and frame timing of this application
 } Application;
 
 typedef struct {
@@ -142,6 +192,7 @@ typedef struct {
 	float x;
 	float y;
 	SDL_Texture *texture;
+	eng_Handle handle;
 } eng_Texture;
 
 typedef struct {
@@ -151,6 +202,7 @@ typedef struct {
 	float y;
 	TTF_Text *text;
 	SDL_Texture *texture;
+	eng_Handle handle;
 } eng_Text;
 
 /*
@@ -158,11 +210,56 @@ typedef struct {
 */
 ENG_RESULT eng_init(bool debug);
 
+/*
+* Same as eng_init without the video subsystem, for running simulations on machines without a display. Only
+* eng_createHeadlessApplication and eng_createSimulation work after it
+*/
+ENG_RESULT eng_initHeadless(bool debug);
+
 /*
 * Used to create the Application struct, this creates the window and some other aspects
 */
 Application *eng_createApplication(const char *title, const uint32_t width, const uint32_t height);
 
+/*
+* Creates an Application without a window that draws into memory with the software renderer, used for capturing frames
+*/
+Application *eng_createHeadlessApplication(const uint32_t width, const uint32_t height);
+
+/*
+* Creates an Application that runs the game loop without a window as fast as it can, for AI tests and balance runs. eng_pollEvent never
+* waits for the frame rate and only returns replayed events. With renderEvery at 0 there's no renderer, images, text, sprite batches,
+* scenes, streamed chunks and UI icons keep their size and position but have no texture and eng_render does nothing. Otherwise every renderEvery-th eng_render draws into window->pSurface
+* with the software renderer. Run many simulations at once as separate processes, the engine's asset caches and handles are shared
+* by everything in one process
+*/
+Application *eng_createSimulation(const uint32_t width, const uint32_t height, uint32_t renderEvery);
+
+/*
+* Returns weather the next eng_render will draw, always true outside simulations. Use it to skip work that only matters on screen
+*/
+bool eng_isRenderedFrame(Application *app);
+
+/*
+* Destroys an application's window and render queue without shutting the engine down, used to close one of several windows.
+* Rects, images and texts made while its context was current are destroyed too, also ones in custom queues.
+* Scenes, batches and UIs drawn with it have to be destroyed first. Destroying the first application also turns off hot reload, the virtual
+* resolution, the render scale and every post-process pass, since they draw with its renderer. Pass the pointer eng_createApplication returned, not a copy
+*/
+void eng_destroyApplication(Application *app);
+
+/*
+* Every application has its own render queue, events and frame timing. Functions that don't take an application, such as
+* eng_addObjectToRenderQueue, use the calling thread's current context which is the first application's until this is called.
+* Pass NULL to go back to the first application's context.
+*
+* Only the first application gets the virtual resolution, HUD and hot reload. Objects have to be created and removed on the main
+* thread since asset caches and handles are shared, once they're in place a headless application can be drawn or captured on another thread
+*/
+void eng_setCurrentContext(eng_Context *context);
+
+eng_Context *eng_getCurrentContext();
+
 /*
 * This renders the render queue, it should be called in the game loop
 */
@@ -188,10 +285,17 @@ eng_Rect *eng_createRect(uint32_t h, uint32_t w, uint32_t x, uint32_t y, eng_Col
 ENG_RESULT eng_removeFromRenderQueue(void *data);
 
 /*
-* This moves the pointer to a specific position in the queue, -1 will move to the end of the queue
+* Same as eng_removeFromRenderQueue but finds the object straight from its handle instead of searching the queue, it also removes objects from custom queues. STALE_HANDLE is returned if it was already removed
+*/
+ENG_RESULT eng_removeHandle(eng_Handle handle);
+
+/*
+* This moves the pointer to a specific position in the queue, positions start at 1 and negative positions count from the end so -1 will move to the end of the queue
 */
 ENG_RESULT eng_moveToQueuePosition(void *data, int position);
 
+ENG_RESULT eng_moveHandleToQueuePosition(eng_Handle handle, int position);
+
 /*
 * This gets the mouse position and returns that value
 */
@@ -208,10 +312,29 @@ bool eng_isTouchingRects(eng_Rect firstRect, eng_Rect secondRect);
 bool eng_isTouching(float firstX, float firstY, float firstH, float firstW, float secondX, float secondY, float secondH, float secondW);
 
 /*
-* This returns the error, it's just a switch case with every error being stored in a static enum before exiting a function
+* This returns the last error on the calling thread, every thread keeps its own error so loading on another thread can't overwrite it
 */
 const char *eng_getError();
 
+ENG_RESULT eng_getErrorCode();
+
+/*
+* Returns extra context for the last error on the calling thread such as the file that failed to load, empty if there isn't any
+*/
+const char *eng_getErrorDetail();
+
+/*
+* Returns what SDL_GetError said when the last error was set, it may be unrelated if the error didn't come from SDL
+*/
+const char *eng_getErrorSDL();
+
+void eng_clearError();
+
+/*
+* The callback is called for every error on any thread, it's stored atomically so setting it never takes a lock. Pass NULL to remove it
+*/
+void eng_setErrorCallback(eng_ErrorCallback callback);
+
 /*
 * This adds to a custom queue, just set the data in the first RenderQueue to NULL if you haven't added anything yet
 */
@@ -219,8 +342,16 @@ ENG_RESULT eng_addToCustomQueue(RenderQueue *queue, void *object, Type type);
 
 ENG_RESULT eng_renderCustomQueue(Application *app, RenderQueue *customQueue, eng_Color backgroundColor);
 
+/*
+* Destroys every object in a custom queue and the nodes the engine added to it, the first node is left empty for you to free or reuse
+*/
+void eng_destroyCustomQueue(RenderQueue *queue);
+
 eng_Text *eng_createText(Window *window, const char *font, uint32_t fontSize, const char *text, eng_Color color, uint32_t x, uint32_t y);
 
+/*
+* Destroys the object and removes its node, removing the first object moves the second one into the first node
+*/
 ENG_RESULT eng_removeFromCustomRenderQueue(RenderQueue *queue, void *data);
 
 ENG_RESULT eng_addObjectToRenderQueue(void *object, Type type);
@@ -231,6 +362,19 @@ void eng_centerText(Window *pWindow, eng_Text *text);
 
 eng_Rect eng_extractRectFromObject(void *object, Type type);
 
+/*
+* Resizes the window and switches fullscreen on or off, the size is ignored in fullscreen. See present.h to scale the game with the window
+*/
 void eng_windowChangeSize(Window *window, uint32_t width, uint32_t height, bool fullscreen);
 
+/*
+* Packs a color into a single RGBA8 value, red is stored in the highest byte
+*/
+uint32_t eng_packColor(eng_Color color);
+
+/*
+* Unpacks a RGBA8 value made by eng_packColor
+*/
+eng_Color eng_unpackColor(uint32_t color);
+
 #endif
\ No newline at end of file
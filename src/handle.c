@@ -0,0 +1,185 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "handle.h"
+
+#define NO_FREE_SLOT UINT32_MAX
+
+typedef struct {
+	void *object;
+	RenderQueue *node;
+	eng_Context *context; // Current when the object was made, its textures belong to that context's renderer
+	Type type;
+	uint32_t generation;
+	uint32_t nextFree;
+} HandleSlot;
+
+static HandleSlot *slots = NULL;
+static uint32_t slotCount = 0;
+static uint32_t slotCapacity = 0;
+static uint32_t freeSlot = NO_FREE_SLOT;
+static uint32_t liveCount = 0;
+
+static eng_Handle makeHandle(uint32_t index, uint32_t generation) {
+	return (generation << ENG_HANDLE_INDEX_BITS) | index;
+}
+
+static HandleSlot *getSlot(eng_Handle handle) {
+	uint32_t index = handle & ENG_HANDLE_INDEX_MASK;
+	if (handle == ENG_INVALID_HANDLE || index >= slotCount) {
+		return NULL;
+	}
+
+	HandleSlot *slot = &slots[index];
+	if (slot->object == NULL || slot->generation != handle >> ENG_HANDLE_INDEX_BITS) {
+		return NULL;
+	}
+
+	return slot;
+}
+
+eng_Handle eng_createHandle(void *object, Type type) {
+	uint32_t index;
+	if (freeSlot != NO_FREE_SLOT) {
+		index = freeSlot;
+		freeSlot = slots[index].nextFree;
+	} else {
+		if (slotCount == ENG_MAX_HANDLES) {
+			eng_setError(OUT_OF_HANDLES);
+			return ENG_INVALID_HANDLE;
+		}
+
+		if (slotCount == slotCapacity) {
+			uint32_t newCapacity = slotCapacity == 0 ? 256 : slotCapacity * 2;
+			HandleSlot *newSlots = realloc(slots, newCapacity * sizeof(HandleSlot));
+			if (newSlots == NULL) {
+				eng_setError(FAILED_TO_MALLOC);
+				return ENG_INVALID_HANDLE;
+			}
+			eng_trackMemory(ENG_MEMORY_POOLS, (int64_t)(newCapacity - slotCapacity) * sizeof(HandleSlot), slotCapacity == 0 ? 1 : 0);
+			slots = newSlots;
+			slotCapacity = newCapacity;
+		}
+
+		index = slotCount++;
+		// Generation 0 is skipped so a zeroed handle is never valid
+		slots[index].generation = 1;
+	}
+
+	HandleSlot *slot = &slots[index];
+	slot->object = object;
+	slot->node = NULL;
+	slot->context = eng_getCurrentContext();
+	slot->type = type;
+	slot->nextFree = NO_FREE_SLOT;
+	liveCount++;
+
+	return makeHandle(index, slot->generation);
+}
+
+void eng_releaseHandle(eng_Handle handle) {
+	HandleSlot *slot = getSlot(handle);
+	if (slot == NULL) {
+		return;
+	}
+
+	slot->object = NULL;
+	slot->node = NULL;
+	slot->generation = (slot->generation + 1) & ENG_HANDLE_GENERATION_MASK;
+	if (slot->generation == 0) {
+		slot->generation = 1;
+	}
+
+	uint32_t index = handle & ENG_HANDLE_INDEX_MASK;
+	slot->nextFree = freeSlot;
+	freeSlot = index;
+	liveCount--;
+}
+
+void eng_setHandleNode(eng_Handle handle, RenderQueue *node) {
+	HandleSlot *slot = getSlot(handle);
+	if (slot != NULL) {
+		slot->node = node;
+	}
+}
+
+RenderQueue *eng_getHandleNode(eng_Handle handle) {
+	HandleSlot *slot = getSlot(handle);
+	if (slot == NULL) {
+		eng_setError(STALE_HANDLE);
+		return NULL;
+	}
+
+	return slot->node;
+}
+
+ENG_RESULT eng_relocateHandle(eng_Handle handle, void *object) {
+	HandleSlot *slot = getSlot(handle);
+	if (slot == NULL) {
+		return eng_setError(STALE_HANDLE);
+	}
+
+	if (object == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	eng_moveTrackedAsset(slot->object, object);
+	if (slot->node != NULL) {
+		slot->node->data = object;
+	}
+	slot->object = object;
+	eng_markQueueChanged(slot->node);
+
+	return SUCCESS;
+}
+
+void *eng_getObject(eng_Handle handle, Type *type) {
+	HandleSlot *slot = getSlot(handle);
+	if (slot == NULL) {
+		eng_setError(STALE_HANDLE);
+		return NULL;
+	}
+
+	if (type != NULL) {
+		*type = slot->type;
+	}
+
+	return slot->object;
+}
+
+bool eng_isHandleValid(eng_Handle handle) {
+	return getSlot(handle) != NULL;
+}
+
+uint32_t eng_getHandleCount() {
+	return liveCount;
+}
+
+void *eng_nextLiveObject(eng_Context *context, uint32_t *cursor, Type *type) {
+	while (*cursor < slotCount) {
+		HandleSlot *slot = &slots[(*cursor)++];
+		if (slot->object != NULL && (context == NULL || slot->context == context)) {
+			*type = slot->type;
+			return slot->object;
+		}
+	}
+
+	return NULL;
+}
+
+void eng_destroyHandles() {
+	if (slotCapacity > 0) {
+		eng_trackMemory(ENG_MEMORY_POOLS, -(int64_t)(slotCapacity * sizeof(HandleSlot)), -1);
+	}
+	free(slots);
+	slots = NULL;
+	slotCount = 0;
+	slotCapacity = 0;
+	freeSlot = NO_FREE_SLOT;
+	liveCount = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include "engine.h"
+
+/*
+* Generational handles for objects made by eng_createRect, eng_createImage and eng_createText.
+*
+* A handle is a 32 bit value, the low ENG_HANDLE_INDEX_BITS are a slot in the handle table and the rest is the slot's generation.
+* The generation goes up every time an object is destroyed, so a handle to a removed object is detected instead of touching freed memory.
+* Looking up a handle is a single array access and the object can be moved in memory without the handle changing.
+*
+* Generations wrap after ENG_HANDLE_GENERATION_MASK + 1 reuses of the same slot, a handle kept that long can point at a newer object.
+*/
+
+#define ENG_HANDLE_INDEX_BITS 20
+#define ENG_HANDLE_INDEX_MASK ((1u << ENG_HANDLE_INDEX_BITS) - 1)
+#define ENG_HANDLE_GENERATION_MASK ((1u << (32 - ENG_HANDLE_INDEX_BITS)) - 1)
+#define ENG_MAX_HANDLES (ENG_HANDLE_INDEX_MASK + 1)
+
+/*
+* Returns the object a handle points to, or NULL and sets STALE_HANDLE if the object was removed. type can be NULL
+*/
+void *eng_getObject(eng_Handle handle, Type *type);
+
+/*
+* Returns weather the handle still points to a live object, doesn't set an error
+*/
+bool eng_isHandleValid(eng_Handle handle);
+
+/*
+* Returns how many handles are currently live
+*/
+uint32_t eng_getHandleCount();
+
+#endif
@@ -0,0 +1,588 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "hotreload.h"
+
+#define POLL_INTERVAL_MS 500
+
+typedef struct ReloadJob {
+	struct ReloadJob *pNext;
+	char *path;
+	SDL_Surface *surface;
+} ReloadJob;
+
+typedef struct {
+	char *path;
+	char *cachePath; // As it was loaded, the texture and font caches key by it
+	Type type;
+	void *object;
+	eng_Color color;
+	uint32_t fontSize;
+} TrackedAsset;
+
+typedef struct {
+	int descriptor;
+	char *path;
+} WatchedDirectory;
+
+typedef struct {
+	char *path;
+	SDL_Time modified;
+} WatchedFile;
+
+static bool enabled = false;
+static Window *reloadWindow = NULL;
+static SDL_Thread *watcher = NULL;
+static SDL_AtomicInt running;
+
+// Written by the watcher thread, the main thread takes the whole stack at once so there is never a lock
+static void *readyJobs = NULL;
+static ReloadJob *pendingJobs = NULL;
+static ReloadJob *pendingTail = NULL;
+
+static TrackedAsset *tracked = NULL;
+static uint32_t trackedCount = 0;
+static uint32_t trackedCapacity = 0;
+
+static char **rootDirectories = NULL;
+static uint32_t rootDirectoryCount = 0;
+
+#ifdef __linux__
+static int inotifyDescriptor = -1;
+static WatchedDirectory *watches = NULL;
+static uint32_t watchCount = 0;
+static uint32_t watchCapacity = 0;
+#endif
+
+static WatchedFile *files = NULL;
+static uint32_t fileCount = 0;
+static uint32_t fileCapacity = 0;
+
+static char *canonicalPath(const char *path) {
+#ifdef _WIN32
+	return _fullpath(NULL, path, 0);
+#else
+	return realpath(path, NULL);
+#endif
+}
+
+static bool isImage(const char *path) {
+	return eng_hasExtension(path, ".png") || eng_hasExtension(path, ".jpg") || eng_hasExtension(path, ".jpeg") || eng_hasExtension(path, ".bmp");
+}
+
+static bool isFont(const char *path) {
+	return eng_hasExtension(path, ".ttf") || eng_hasExtension(path, ".otf");
+}
+
+static void freeJob(ReloadJob *job) {
+	SDL_DestroySurface(job->surface);
+	free(job->path);
+	free(job);
+}
+
+static void pushReadyJob(ReloadJob *job) {
+	do {
+		job->pNext = SDL_GetAtomicPointer(&readyJobs);
+	} while (!SDL_CompareAndSwapAtomicPointer(&readyJobs, job->pNext, job));
+}
+
+static ReloadJob *takeReadyJobs() {
+	ReloadJob *jobs;
+	do {
+		jobs = SDL_GetAtomicPointer(&readyJobs);
+	} while (!SDL_CompareAndSwapAtomicPointer(&readyJobs, jobs, NULL));
+
+	// The stack hands them back newest first
+	ReloadJob *ordered = NULL;
+	while (jobs != NULL) {
+		ReloadJob *next = jobs->pNext;
+		jobs->pNext = ordered;
+		ordered = jobs;
+		jobs = next;
+	}
+
+	return ordered;
+}
+
+// Runs on the watcher thread, the expensive decode happens here instead of in the frame
+static void handleChange(const char *path) {
+	bool image = isImage(path);
+	if (!image && !isFont(path)) {
+		return;
+	}
+
+	ReloadJob *job = (ReloadJob *)calloc(1, sizeof(ReloadJob));
+	if (job == NULL) {
+		return;
+	}
+
+	job->path = canonicalPath(path);
+	if (job->path == NULL) {
+		free(job);
+		return;
+	}
+
+	if (image) {
+		job->surface = IMG_Load(job->path);
+		if (job->surface == NULL) {
+			// Usually the editor hasn't finished writing, the next write will trigger again
+			freeJob(job);
+			return;
+		}
+	}
+
+	pushReadyJob(job);
+}
+
+static SDL_EnumerationResult scanFile(void *userdata, const char *dirname, const char *fname) {
+	bool report = *(bool *)userdata;
+
+	char path[1024];
+	SDL_PathInfo info;
+	if (!eng_joinPath(path, sizeof(path), dirname, fname) || !SDL_GetPathInfo(path, &info)) {
+		return SDL_ENUM_CONTINUE;
+	}
+
+	if (info.type == SDL_PATHTYPE_DIRECTORY) {
+		SDL_EnumerateDirectory(path, scanFile, userdata);
+		return SDL_ENUM_CONTINUE;
+	}
+
+	for (uint32_t i = 0; i < fileCount; i++) {
+		if (strcmp(files[i].path, path) == 0) {
+			if (files[i].modified != info.modify_time) {
+				files[i].modified = info.modify_time;
+				handleChange(path);
+			}
+			return SDL_ENUM_CONTINUE;
+		}
+	}
+
+	if (fileCount == fileCapacity) {
+		uint32_t newCapacity = fileCapacity == 0 ? 64 : fileCapacity * 2;
+		WatchedFile *newFiles = realloc(files, newCapacity * sizeof(WatchedFile));
+		if (newFiles == NULL) {
+			return SDL_ENUM_CONTINUE;
+		}
+		files = newFiles;
+		fileCapacity = newCapacity;
+	}
+
+	files[fileCount++] = (WatchedFile) {
+		.path = SDL_strdup(path),
+		.modified = info.modify_time,
+	};
+	if (report) {
+		handleChange(path);
+	}
+
+	return SDL_ENUM_CONTINUE;
+}
+
+static void scanDirectories(bool report) {
+	for (uint32_t i = 0; i < rootDirectoryCount; i++) {
+		SDL_EnumerateDirectory(rootDirectories[i], scanFile, &report);
+	}
+}
+
+#ifdef __linux__
+static SDL_EnumerationResult watchSubdirectory(void *userdata, const char *dirname, const char *fname);
+
+static void watchDirectory(const char *path) {
+	int descriptor = inotify_add_watch(inotifyDescriptor, path, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (descriptor < 0) {
+		return;
+	}
+
+	if (watchCount == watchCapacity) {
+		uint32_t newCapacity = watchCapacity == 0 ? 32 : watchCapacity * 2;
+		WatchedDirectory *newWatches = realloc(watches, newCapacity * sizeof(WatchedDirectory));
+		if (newWatches == NULL) {
+			return;
+		}
+		watches = newWatches;
+		watchCapacity = newCapacity;
+	}
+
+	watches[watchCount++] = (WatchedDirectory) {
+		.descriptor = descriptor,
+		.path = SDL_strdup(path),
+	};
+
+	SDL_EnumerateDirectory(path, watchSubdirectory, NULL);
+}
+
+static SDL_EnumerationResult watchSubdirectory(void *userdata, const char *dirname, const char *fname) {
+	char path[1024];
+	SDL_PathInfo info;
+	if (eng_joinPath(path, sizeof(path), dirname, fname) && SDL_GetPathInfo(path, &info) && info.type == SDL_PATHTYPE_DIRECTORY) {
+		watchDirectory(path);
+	}
+
+	return SDL_ENUM_CONTINUE;
+}
+
+static const char *getWatchedPath(int descriptor) {
+	for (uint32_t i = 0; i < watchCount; i++) {
+		if (watches[i].descriptor == descriptor) {
+			return watches[i].path;
+		}
+	}
+
+	return NULL;
+}
+
+static void readNotifications() {
+	union {
+		struct inotify_event event;
+		char bytes[4096];
+	} buffer;
+
+	ssize_t length = read(inotifyDescriptor, buffer.bytes, sizeof(buffer.bytes));
+	const char *curr = buffer.bytes;
+	while (length > 0 && curr < buffer.bytes + length) {
+		const struct inotify_event *event = (const struct inotify_event *)curr;
+		curr += sizeof(struct inotify_event) + event->len;
+
+		const char *directory = getWatchedPath(event->wd);
+		char path[1024];
+		if (directory == NULL || event->len == 0 || !eng_joinPath(path, sizeof(path), directory, event->name)) {
+			continue;
+		}
+
+		if (event->mask & IN_ISDIR) {
+			watchDirectory(path);
+		} else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+			handleChange(path);
+		}
+	}
+}
+#endif
+
+static int watchThread(void *data) {
+	while (SDL_GetAtomicInt(&running)) {
+#ifdef __linux__
+		if (inotifyDescriptor >= 0) {
+			struct pollfd descriptor = (struct pollfd) {
+				.fd = inotifyDescriptor,
+				.events = POLLIN,
+			};
+			if (poll(&descriptor, 1, 100) > 0) {
+				readNotifications();
+			}
+			continue;
+		}
+#endif
+		for (int waited = 0; waited < POLL_INTERVAL_MS && SDL_GetAtomicInt(&running); waited += 50) {
+			SDL_Delay(50);
+		}
+		scanDirectories(true);
+	}
+
+	return 0;
+}
+
+void eng_trackAsset(const char *path, Type type, void *object, eng_Color color, uint32_t fontSize) {
+	if (!enabled || path == NULL || object == NULL) {
+		return;
+	}
+
+	char *fullPath = canonicalPath(path);
+	if (fullPath == NULL) {
+		return;
+	}
+
+	char *cachePath = SDL_strdup(path);
+	if (cachePath == NULL) {
+		free(fullPath);
+		return;
+	}
+
+	if (trackedCount == trackedCapacity) {
+		uint32_t newCapacity = trackedCapacity == 0 ? 64 : trackedCapacity * 2;
+		TrackedAsset *newTracked = realloc(tracked, newCapacity * sizeof(TrackedAsset));
+		if (newTracked == NULL) {
+			free(fullPath);
+			SDL_free(cachePath);
+			return;
+		}
+		tracked = newTracked;
+		trackedCapacity = newCapacity;
+	}
+
+	tracked[trackedCount++] = (TrackedAsset) {
+		.path = fullPath,
+		.cachePath = cachePath,
+		.type = type,
+		.object = object,
+		.color = color,
+		.fontSize = fontSize,
+	};
+}
+
+void eng_untrackAsset(void *object) {
+	for (uint32_t i = 0; i < trackedCount; i++) {
+		if (tracked[i].object == object) {
+			free(tracked[i].path);
+			SDL_free(tracked[i].cachePath);
+			tracked[i] = tracked[--trackedCount];
+			return;
+		}
+	}
+}
+
+void eng_moveTrackedAsset(void *object, void *newObject) {
+	for (uint32_t i = 0; i < trackedCount; i++) {
+		if (tracked[i].object == object) {
+			tracked[i].object = newObject;
+			return;
+		}
+	}
+}
+
+// The text switches to the reloaded font from the font cache, so it's shared with texts made afterwards
+static bool reloadText(TrackedAsset *asset) {
+	eng_Text *text = asset->object;
+	if (text->text == NULL || text->text->text == NULL) {
+		return false;
+	}
+
+	TTF_Font *font = eng_acquireFont(asset->cachePath, asset->fontSize);
+	if (font == NULL) {
+		return false;
+	}
+
+	SDL_Color color = (SDL_Color) {
+		.r = asset->color.r,
+		.g = asset->color.g,
+		.b = asset->color.b,
+		.a = asset->color.a,
+	};
+	SDL_Surface *surface = TTF_RenderText_Blended(font, text->text->text, strlen(text->text->text), color);
+	if (surface == NULL) {
+		eng_releaseFont(font);
+		return false;
+	}
+
+	SDL_Texture *texture = eng_createTextureFromSurface(reloadWindow->pRenderer, surface);
+	TTF_Font *oldFont = TTF_GetTextFont(text->text);
+	if (texture == NULL || !TTF_SetTextFont(text->text, font)) {
+		eng_destroyTexture(texture);
+		eng_releaseFont(font);
+		SDL_DestroySurface(surface);
+		return false;
+	}
+	eng_releaseFont(oldFont);
+
+	eng_destroyTexture(text->texture);
+	text->texture = texture;
+	if (text->w != surface->w || text->h != surface->h) {
+		text->w = surface->w;
+		text->h = surface->h;
+		eng_markObjectMoved(text->handle);
+	}
+	SDL_DestroySurface(surface);
+
+	return true;
+}
+
+static bool isJobFor(ReloadJob *job, TrackedAsset *asset) {
+	Type type = job->surface != NULL ? TYPE_TEXTURE : TYPE_TEXT;
+	return asset->type == type && strcmp(asset->path, job->path) == 0;
+}
+
+static void applyJob(ReloadJob *job) {
+	uint32_t updated = 0;
+
+	// Objects made from now on load the new file instead of sharing the old texture or font.
+	// All of them go stale before anything is acquired so the new entries aren't invalidated again
+	if (job->surface != NULL) {
+		eng_invalidateCachedTexture(job->path);
+	} else {
+		eng_invalidateCachedFont(job->path);
+	}
+	for (uint32_t i = 0; i < trackedCount; i++) {
+		if (!isJobFor(job, &tracked[i])) {
+			continue;
+		}
+
+		if (job->surface != NULL) {
+			eng_invalidateCachedTexture(tracked[i].cachePath);
+		} else {
+			eng_invalidateCachedFont(tracked[i].cachePath);
+		}
+	}
+
+	for (uint32_t i = 0; i < trackedCount; i++) {
+		TrackedAsset *asset = &tracked[i];
+		if (!isJobFor(job, asset)) {
+			continue;
+		}
+
+		if (asset->type == TYPE_TEXT) {
+			updated += reloadText(asset);
+			continue;
+		}
+
+		// The first image uploads the surface into the cache, every other image of the file shares that texture
+		eng_Texture *texture = asset->object;
+		SDL_Texture *newTexture = eng_acquireTextureFromSurface(reloadWindow->pRenderer, asset->cachePath, job->surface);
+		if (newTexture == NULL) {
+			continue;
+		}
+
+		// Keeps a filter picked with eng_setImageFilter
+		SDL_ScaleMode scaleMode;
+		if (texture->texture != NULL && SDL_GetTextureScaleMode(texture->texture, &scaleMode)) {
+			SDL_SetTextureScaleMode(newTexture, scaleMode);
+		}
+		eng_releaseTexture(texture->texture);
+		texture->texture = newTexture;
+		updated++;
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Reloaded %s\tObjects updated: %d", job->path, updated);
+}
+
+void eng_applyHotReload() {
+	if (!enabled) {
+		return;
+	}
+
+	ReloadJob *jobs = takeReadyJobs();
+	if (jobs != NULL) {
+		if (pendingTail != NULL) {
+			pendingTail->pNext = jobs;
+		} else {
+			pendingJobs = jobs;
+		}
+		for (pendingTail = jobs; pendingTail->pNext != NULL; pendingTail = pendingTail->pNext);
+	}
+
+	// Only a few uploads per frame so a folder of changes doesn't turn into one long frame
+	for (int i = 0; i < ENG_HOT_RELOAD_JOBS_PER_FRAME && pendingJobs != NULL; i++) {
+		ReloadJob *job = pendingJobs;
+		pendingJobs = job->pNext;
+		if (pendingJobs == NULL) {
+			pendingTail = NULL;
+		}
+
+		applyJob(job);
+		freeJob(job);
+	}
+}
+
+ENG_RESULT eng_enableHotReload(Window *window, const char **directories, uint32_t count) {
+	if (window == NULL || directories == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	eng_disableHotReload();
+
+	rootDirectories = (char **)calloc(count, sizeof(char *));
+	if (rootDirectories == NULL && count > 0) {
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		rootDirectories[i] = SDL_strdup(directories[i]);
+	}
+	rootDirectoryCount = count;
+	reloadWindow = window;
+
+#ifdef __linux__
+	inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyDescriptor >= 0) {
+		for (uint32_t i = 0; i < count; i++) {
+			watchDirectory(directories[i]);
+		}
+	} else {
+		scanDirectories(false);
+	}
+#else
+	scanDirectories(false);
+#endif
+
+	SDL_SetAtomicInt(&running, 1);
+	watcher = SDL_CreateThread(watchThread, "eng_hotreload", NULL);
+	if (watcher == NULL) {
+		eng_disableHotReload();
+		return eng_setError(FAILED_TO_START_THREAD);
+	}
+
+	enabled = true;
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Hot reload watching %d directories", count);
+
+	return SUCCESS;
+}
+
+void eng_disableHotReload() {
+	SDL_SetAtomicInt(&running, 0);
+	if (watcher != NULL) {
+		SDL_WaitThread(watcher, NULL);
+		watcher = NULL;
+	}
+	enabled = false;
+
+#ifdef __linux__
+	if (inotifyDescriptor >= 0) {
+		close(inotifyDescriptor);
+		inotifyDescriptor = -1;
+	}
+	for (uint32_t i = 0; i < watchCount; i++) {
+		SDL_free(watches[i].path);
+	}
+	free(watches);
+	watches = NULL;
+	watchCount = watchCapacity = 0;
+#endif
+
+	for (uint32_t i = 0; i < fileCount; i++) {
+		SDL_free(files[i].path);
+	}
+	free(files);
+	files = NULL;
+	fileCount = fileCapacity = 0;
+
+	for (uint32_t i = 0; i < rootDirectoryCount; i++) {
+		SDL_free(rootDirectories[i]);
+	}
+	free(rootDirectories);
+	rootDirectories = NULL;
+	rootDirectoryCount = 0;
+
+	for (uint32_t i = 0; i < trackedCount; i++) {
+		free(tracked[i].path);
+		SDL_free(tracked[i].cachePath);
+	}
+	free(tracked);
+	tracked = NULL;
+	trackedCount = trackedCapacity = 0;
+
+	ReloadJob *job = takeReadyJobs();
+	while (job != NULL) {
+		ReloadJob *next = job->pNext;
+		freeJob(job);
+		job = next;
+	}
+	while (pendingJobs != NULL) {
+		ReloadJob *next = pendingJobs->pNext;
+		freeJob(pendingJobs);
+		pendingJobs = next;
+	}
+	pendingTail = NULL;
+}
@@ -0,0 +1,26 @@
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+#include "engine.h"
+
+/*
+* Development mode that reloads images and fonts when they change on disk.
+*
+* A background thread watches the directories (inotify on Linux, polling elsewhere) and decodes changed images, the new textures are swapped into every eng_Texture and eng_Text that uses the file at the start of the next eng_render.
+* A changed image is uploaded once into the texture cache and shared by all of its images, a changed font replaces the cached font so texts made
+* afterwards use it too.
+*/
+
+#define ENG_HOT_RELOAD_JOBS_PER_FRAME 2
+
+/*
+* Starts watching the directories and every subdirectory, only objects created after this is called are reloaded
+*/
+ENG_RESULT eng_enableHotReload(Window *window, const char **directories, uint32_t count);
+
+/*
+* Stops the watcher thread and forgets every tracked object
+*/
+void eng_disableHotReload();
+
+#endif
@@ -0,0 +1,153 @@
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "batch.h"
+#include "hud.h"
+#include "budget.h"
+
+#define HUD_LEFT 8.0f
+#define HUD_TOP 8.0f
+#define HUD_PADDING 4.0f
+#define HUD_BAR_WIDTH 2.0f
+#define HUD_GRAPH_HEIGHT 48.0f
+#define HUD_GRAPH_MAX_MS 33.3f
+#define HUD_LINE_HEIGHT 10.0f
+#define HUD_LINES 6
+
+static bool hudEnabled = false;
+static eng_RectBatch *hudBatch = NULL;
+
+// stats holds the last finished frame, the counters below are for the frame being drawn and are atomic since offscreen
+// applications can draw on other threads
+static eng_Stats stats;
+static SDL_AtomicInt drawCalls;
+static SDL_AtomicInt batches;
+static SDL_AtomicInt allocations;
+static SDL_AtomicInt events;
+static uint64_t lastFrameNS = 0;
+
+void eng_setHudEnabled(bool enabled) {
+	hudEnabled = enabled;
+}
+
+bool eng_isHudEnabled() {
+	return hudEnabled;
+}
+
+void eng_getStats(eng_Stats *out) {
+	if (out == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	*out = stats;
+}
+
+void eng_countDrawCalls(uint32_t calls, uint32_t batchCount) {
+	SDL_AddAtomicInt(&drawCalls, calls);
+	SDL_AddAtomicInt(&batches, batchCount);
+}
+
+void eng_countAllocation() {
+	SDL_AddAtomicInt(&allocations, 1);
+}
+
+void eng_countEvent() {
+	SDL_AddAtomicInt(&events, 1);
+}
+
+void eng_finishFrame(uint32_t queueLength) {
+	uint64_t now = SDL_GetTicksNS();
+	stats.frameMS = lastFrameNS == 0 ? 0 : (float)(now - lastFrameNS) / SDL_NS_PER_MS;
+	lastFrameNS = now;
+
+	stats.frameHistory[stats.historyIndex] = stats.frameMS;
+	stats.historyIndex = (stats.historyIndex + 1) % ENG_STATS_HISTORY;
+	stats.frame++;
+
+	stats.drawCalls = SDL_SetAtomicInt(&drawCalls, 0);
+	stats.batches = SDL_SetAtomicInt(&batches, 0);
+	stats.queueLength = queueLength;
+	stats.allocations = SDL_SetAtomicInt(&allocations, 0);
+	stats.events = SDL_SetAtomicInt(&events, 0);
+
+	eng_MemoryStats memory;
+	eng_getMemoryStats(&memory);
+	stats.textureBytes = memory.categories[ENG_MEMORY_TEXTURES].bytes;
+	stats.textureCount = memory.categories[ENG_MEMORY_TEXTURES].count;
+
+	stats.passCount = eng_getPostPassTimes(stats.passes, ENG_MAX_POST_PASSES);
+}
+
+static uint32_t getBarColor(float ms) {
+	if (ms <= 1000.0f / 60.0f) {
+		return 0x40D040FF;
+	} else if (ms <= 1000.0f / 30.0f) {
+		return 0xE0C040FF;
+	}
+
+	return 0xE04040FF;
+}
+
+void eng_renderHud(SDL_Renderer *renderer) {
+	if (!hudEnabled) {
+		return;
+	}
+
+	uint64_t start = SDL_GetTicksNS();
+
+	if (hudBatch == NULL) {
+		hudBatch = eng_createRectBatch(ENG_STATS_HISTORY + 2);
+		if (hudBatch == NULL) {
+			return;
+		}
+	}
+	eng_rectBatchClear(hudBatch);
+
+	float width = ENG_STATS_HISTORY * HUD_BAR_WIDTH + HUD_PADDING * 2;
+	float height = HUD_GRAPH_HEIGHT + (HUD_LINES + stats.passCount) * HUD_LINE_HEIGHT + HUD_PADDING * 3;
+	float graphBottom = HUD_TOP + HUD_PADDING + HUD_GRAPH_HEIGHT;
+	eng_rectBatchAdd(hudBatch, height, width, HUD_LEFT, HUD_TOP, 0x000000C0);
+
+	// Oldest frame on the left
+	for (uint32_t i = 0; i < ENG_STATS_HISTORY; i++) {
+		float ms = stats.frameHistory[(stats.historyIndex + i) % ENG_STATS_HISTORY];
+		float barHeight = SDL_min(ms / HUD_GRAPH_MAX_MS, 1.0f) * HUD_GRAPH_HEIGHT;
+		eng_rectBatchAdd(hudBatch, barHeight, HUD_BAR_WIDTH, HUD_LEFT + HUD_PADDING + i * HUD_BAR_WIDTH, graphBottom - barHeight, getBarColor(ms));
+	}
+
+	float targetY = graphBottom - (1000.0f / 60.0f) / HUD_GRAPH_MAX_MS * HUD_GRAPH_HEIGHT;
+	eng_rectBatchAdd(hudBatch, 1, width - HUD_PADDING * 2, HUD_LEFT + HUD_PADDING, targetY, 0xFFFFFF60);
+
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	eng_renderRectBatch(renderer, hudBatch);
+	SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+
+	float x = HUD_LEFT + HUD_PADDING;
+	float y = graphBottom + HUD_PADDING;
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	SDL_RenderDebugTextFormat(renderer, x, y, "Frame %.2f ms  %.0f fps", stats.frameMS, stats.frameMS > 0 ? 1000.0f / stats.frameMS : 0.0f);
+	SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT, "Draw calls %u  Batches %u", stats.drawCalls, stats.batches);
+	SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT * 2, "Queue %u  Events %u", stats.queueLength, stats.events);
+	SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT * 3, "Textures %u  %.2f MB", stats.textureCount, (double)stats.textureBytes / (1024.0 * 1024.0));
+	SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT * 4, "Allocations %u", stats.allocations);
+	SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT * 5, "HUD %.3f ms", stats.hudMS);
+	for (uint32_t i = 0; i < stats.passCount; i++) {
+		SDL_RenderDebugTextFormat(renderer, x, y + HUD_LINE_HEIGHT * (HUD_LINES + i), "Post %s %.3f ms", stats.passes[i].name, stats.passes[i].ms);
+	}
+
+	stats.hudMS = (float)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+}
+
+void eng_destroyHud() {
+	eng_destroyRectBatch(hudBatch);
+	hudBatch = NULL;
+}
@@ -0,0 +1,49 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include "engine.h"
+#include "postfx.h"
+
+/*
+* Engine counters and the performance overlay that draws them.
+*
+* Counters are collected every frame whether or not the overlay is showing, eng_getStats returns the last finished frame so the values can be sent to telemetry.
+*/
+
+#define ENG_STATS_HISTORY 120
+
+typedef struct {
+	uint64_t frame;
+	float frameMS;
+	float frameHistory[ENG_STATS_HISTORY];
+	uint32_t historyIndex;
+
+	uint32_t drawCalls;
+	uint32_t batches;
+	uint32_t queueLength;
+	uint32_t allocations;
+	uint32_t events;
+
+	uint64_t textureBytes;
+	uint32_t textureCount;
+
+	float hudMS;
+
+	// Post-process passes that ran, in the order they ran
+	uint32_t passCount;
+	eng_PassTime passes[ENG_MAX_POST_PASSES];
+} eng_Stats;
+
+/*
+* Shows or hides the overlay in the top left of the window
+*/
+void eng_setHudEnabled(bool enabled);
+
+bool eng_isHudEnabled();
+
+/*
+* Copies the counters from the last finished frame
+*/
+void eng_getStats(eng_Stats *stats);
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef INTERNAL_H
+#define INTERNAL_H
+
+#include "engine.h"
+#include "budget.h"
+#include "postfx.h"
+
+/*
+* Functions shared between the engine's source files, these aren't part of the public API and shouldn't be called by games
+*/
+
+/*
+* Stores the error for the calling thread so eng_getError can report it and returns it so it can be used in a return statement
+*/
+ENG_RESULT eng_setError(ENG_RESULT code);
+
+/*
+* Same as eng_setError with a printf style detail message, use it whenever there's a path or name that would help find the problem
+*/
+ENG_RESULT eng_setErrorDetail(ENG_RESULT code, const char *format, ...);
+
+/*
+* Returns weather debug was enabled in eng_init
+*/
+bool eng_isDebug();
+
+/*
+* Loads an image from disk into a texture, every image the engine loads goes through this so it's the single place that decodes files
+*/
+SDL_Texture *eng_loadTexture(SDL_Renderer *renderer, const char *path);
+
+/*
+* Decodes the image at path only for its size, this is for simulations without a renderer that still need the geometry
+*/
+bool eng_loadImageSize(const char *path, int *w, int *h);
+
+/*
+* Returns weather the path ends with the extension, the check ignores case
+*/
+bool eng_hasExtension(const char *path, const char *extension);
+
+/*
+* Writes directory/name into path, returns false if it didn't fit
+*/
+bool eng_joinPath(char *path, size_t length, const char *directory, const char *name);
+
+/*
+* Remembers which file an object was created from so hot reload can update it, these do nothing while hot reload is off
+*/
+void eng_trackAsset(const char *path, Type type, void *object, eng_Color color, uint32_t fontSize);
+
+void eng_untrackAsset(void *object);
+
+/*
+* Points a tracked asset at the object's new address after it was moved
+*/
+void eng_moveTrackedAsset(void *object, void *newObject);
+
+/*
+* Draws the render queue without presenting it, eng_render presents straight after this
+*/
+void eng_drawRenderQueue(Application *app, eng_Color backgroundColor);
+
+/*
+* Feeds recorded input back into eng_pollEvent, returns true when a replay handled the poll and result should be returned as is
+*/
+bool eng_replayPollEvent(Application *app, bool *result);
+
+/*
+* Records what a call to eng_pollEvent produced while recording is on
+*/
+void eng_recordPoll(Application *app, bool result);
+
+/*
+* Counters shown by the performance overlay, see hud.h
+*/
+void eng_countDrawCalls(uint32_t calls, uint32_t batchCount);
+
+void eng_countAllocation();
+
+void eng_countEvent();
+
+/*
+* Textures made by the engine should be created and destroyed through these so texture memory stays accurate
+*/
+SDL_Texture *eng_createTextureFromSurface(SDL_Renderer *renderer, SDL_Surface *surface);
+
+void eng_addTextureMemory(SDL_Texture *texture);
+
+void eng_destroyTexture(SDL_Texture *texture);
+
+/*
+* Memory accounting, see budget.h. bytes and count are added to the category, pass negative values when freeing
+*/
+void eng_trackMemory(ENG_MEMORY_CATEGORY category, int64_t bytes, int32_t count);
+
+/*
+* Returns the shared texture for an image file, loading it if it isn't cached. Every acquire needs a release
+*/
+SDL_Texture *eng_acquireTexture(SDL_Renderer *renderer, const char *path);
+
+/*
+* Same as eng_acquireTexture for an image that was already decoded, the surface is only uploaded if the file isn't cached. The caller keeps the surface
+*/
+SDL_Texture *eng_acquireTextureFromSurface(SDL_Renderer *renderer, const char *path, SDL_Surface *surface);
+
+/*
+* Gives back a texture from eng_acquireTexture, textures that didn't come from the cache are destroyed
+*/
+void eng_releaseTexture(SDL_Texture *texture);
+
+/*
+* Stops handing out the cached texture for a file that changed on disk, it's freed once the images using it let go
+*/
+void eng_invalidateCachedTexture(const char *path);
+
+/*
+* Shared fonts by path and size, every acquire needs a release
+*/
+TTF_Font *eng_acquireFont(const char *path, uint32_t size);
+
+void eng_releaseFont(TTF_Font *font);
+
+/*
+* Stops handing out the cached fonts for a file that changed on disk, every size is closed once the texts using it let go
+*/
+void eng_invalidateCachedFont(const char *path);
+
+/*
+* Frees every cached texture and font, called by eng_quit before the renderer is destroyed
+*/
+void eng_destroyMemoryCaches();
+
+/*
+* Frees the cached textures made for a renderer, called before the renderer of an application is destroyed
+*/
+void eng_destroyRendererTextures(SDL_Renderer *renderer);
+
+/*
+* Logs whatever memory is still counted as leaked along with the high-water marks
+*/
+void eng_reportMemory();
+
+/*
+* Writes the two triangles of every quad from from up to to, shared by everything that draws quads with one geometry call
+*/
+void eng_fillQuadIndices(int *indices, uint32_t from, uint32_t to);
+
+/*
+* Draws the overlay if it's enabled, called after the render queue so it sits on top
+*/
+void eng_renderHud(SDL_Renderer *renderer);
+
+/*
+* Stores this frame's counters for eng_getStats and starts counting the next frame
+*/
+void eng_finishFrame(uint32_t queueLength);
+
+void eng_destroyHud();
+
+/*
+* Swaps reloaded textures into their objects, called at the start of every frame
+*/
+void eng_applyHotReload();
+
+/*
+* Handle table, see handle.h. Handles are made when an object is created and released when it's destroyed
+*/
+eng_Handle eng_createHandle(void *object, Type type);
+
+void eng_releaseHandle(eng_Handle handle);
+
+/*
+* Remembers the render queue or custom queue node holding the object so it can be removed or moved without searching the queue
+*/
+void eng_setHandleNode(eng_Handle handle, RenderQueue *node);
+
+RenderQueue *eng_getHandleNode(eng_Handle handle);
+
+/*
+* Updates the handle, the render queue and hot reload after an object was copied to a new address, the old memory can be freed afterwards
+*/
+ENG_RESULT eng_relocateHandle(eng_Handle handle, void *object);
+
+void eng_destroyHandles();
+
+/*
+* Returns the next live object from cursor onwards or NULL when there are no more, start cursor at 0.
+* With a context only objects made while it was current are returned, NULL returns objects from every context
+*/
+void *eng_nextLiveObject(eng_Context *context, uint32_t *cursor, Type *type);
+
+/*
+* Returns the first node of the main render queue
+*/
+RenderQueue *eng_getRenderQueue();
+
+/*
+* Layout versions tell pick indexes the objects in a queue were added, removed, moved or resized so they rebuild before the next pick,
+* see pick.h. Every render queue and custom queue has its own version, NULL is the current context's render queue
+*/
+uint32_t eng_getQueueVersion(RenderQueue *queue);
+
+/*
+* Changes the version of the queue holding node, which can be any node of a render queue or custom queue
+*/
+void eng_markQueueChanged(RenderQueue *node);
+
+/*
+* Changes the version of the queue holding the object, objects that aren't in a queue are ignored
+*/
+void eng_markObjectMoved(eng_Handle handle);
+
+/*
+* Virtual resolution and render scale, see present.h. The scaled frame functions wrap drawing the render queue in eng_render
+*/
+void eng_updateWindowSize(Window *window);
+
+void eng_beginScaledFrame(Window *window);
+
+void eng_endScaledFrame(Window *window);
+
+/*
+* Adjusts the dynamic render scale after a frame is presented, sleptNS is how long the fps limit slept during the frame
+*/
+void eng_updateRenderScale(uint64_t sleptNS);
+
+/*
+* Converts a position in the window to virtual coordinates, positions in windows without a virtual resolution are left as they are
+*/
+void eng_windowToVirtual(Window *window, float *x, float *y);
+
+/*
+* Returns weather the window's size is the virtual resolution instead of its real size
+*/
+bool eng_hasVirtualResolution(Window *window);
+
+/*
+* Switches a newly loaded texture to nearest sampling in pixel art mode
+*/
+void eng_applyTextureFilter(SDL_Texture *texture);
+
+void eng_destroyPresent();
+
+/*
+* Redirects the frame into the post-process target when a pass is active, eng_endPostProcess runs the passes and draws the result
+*/
+void eng_beginPostProcess(Window *window);
+
+void eng_endPostProcess(Window *window);
+
+/*
+* Copies the times of the passes that ran since the last call into out, returns how many were copied
+*/
+uint32_t eng_getPostPassTimes(eng_PassTime *out, uint32_t max);
+
+/*
+* Stops the music thread, closes the audio device and frees every cached sound
+*/
+void eng_quitAudio();
+
+#endif
@@ -0,0 +1,218 @@
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+
+#define FLUSH_INTERVAL_MS 5
+#define OUTPUT_BUFFER_SIZE 16384
+
+typedef struct {
+	SDL_AtomicU32 sequence;
+	uint8_t level;
+	uint8_t category;
+	uint64_t timeNS;
+	char message[ENG_LOG_MESSAGE_LENGTH];
+} LogRecord;
+
+// Bounded multi producer queue, a slot can be written when its sequence equals the write position
+// and read when it equals the write position + 1, the flush thread is the only reader
+static LogRecord records[ENG_LOG_CAPACITY];
+static SDL_AtomicU32 writePosition;
+static uint32_t readPosition = 0;
+static bool initialized = false;
+
+static SDL_AtomicInt running;
+static SDL_AtomicU32 dropped;
+static SDL_Thread *flusher = NULL;
+static SDL_IOStream *logFile = NULL;
+
+static ENG_LOG_LEVEL minimumLevel = ENG_LOG_INFO;
+static bool categoryEnabled[ENG_LOG_CATEGORY_COUNT] = {true, true, true, true, true, true, true};
+
+static char outputBuffer[OUTPUT_BUFFER_SIZE];
+static uint32_t outputLength = 0;
+
+static const char *levelNames[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+static const char *categoryNames[] = {"core", "queue", "render", "asset", "input", "game", "audio"};
+
+static void writeOutput() {
+	if (outputLength == 0) {
+		return;
+	}
+
+	if (logFile != NULL) {
+		SDL_WriteIO(logFile, outputBuffer, outputLength);
+	} else {
+		fwrite(outputBuffer, 1, outputLength, stdout);
+		fflush(stdout);
+	}
+	outputLength = 0;
+}
+
+static uint32_t drainRecords() {
+	uint32_t count = 0;
+
+	while (true) {
+		LogRecord *record = &records[readPosition & (ENG_LOG_CAPACITY - 1)];
+		if (SDL_GetAtomicU32(&record->sequence) != readPosition + 1) {
+			break;
+		}
+
+		char line[ENG_LOG_MESSAGE_LENGTH + 48];
+		int length = SDL_snprintf(line, sizeof(line), "[%10.4f] %-5s %-6s %s\n",
+			(double)record->timeNS / SDL_NS_PER_SECOND, levelNames[record->level], categoryNames[record->category], record->message);
+		length = SDL_min(length, (int)sizeof(line) - 1);
+
+		// Hands the slot back to the producers for the next lap around the ring
+		SDL_SetAtomicU32(&record->sequence, readPosition + ENG_LOG_CAPACITY);
+		readPosition++;
+		count++;
+
+		if (outputLength + length > OUTPUT_BUFFER_SIZE) {
+			writeOutput();
+		}
+		memcpy(outputBuffer + outputLength, line, length);
+		outputLength += length;
+	}
+
+	writeOutput();
+
+	return count;
+}
+
+static int flushThread(void *data) {
+	while (SDL_GetAtomicInt(&running)) {
+		if (drainRecords() == 0) {
+			SDL_Delay(FLUSH_INTERVAL_MS);
+		}
+	}
+	drainRecords();
+
+	return 0;
+}
+
+ENG_RESULT eng_startLogging(const char *path) {
+	eng_stopLogging();
+
+	if (!initialized) {
+		for (uint32_t i = 0; i < ENG_LOG_CAPACITY; i++) {
+			SDL_SetAtomicU32(&records[i].sequence, i);
+		}
+		SDL_SetAtomicU32(&writePosition, 0);
+		readPosition = 0;
+		initialized = true;
+	}
+
+	if (path != NULL) {
+		logFile = SDL_IOFromFile(path, "wb");
+		if (logFile == NULL) {
+			return eng_setErrorDetail(FAILED_TO_OPEN_LOG, "%s", path);
+		}
+	}
+
+	SDL_SetAtomicInt(&running, 1);
+	flusher = SDL_CreateThread(flushThread, "eng_log", NULL);
+	if (flusher == NULL) {
+		SDL_SetAtomicInt(&running, 0);
+		if (logFile != NULL) {
+			SDL_CloseIO(logFile);
+			logFile = NULL;
+		}
+		return eng_setError(FAILED_TO_START_THREAD);
+	}
+
+	return SUCCESS;
+}
+
+void eng_stopLogging() {
+	if (flusher == NULL) {
+		return;
+	}
+
+	SDL_SetAtomicInt(&running, 0);
+	SDL_WaitThread(flusher, NULL);
+	flusher = NULL;
+
+	if (SDL_GetAtomicU32(&dropped) > 0) {
+		outputLength = SDL_snprintf(outputBuffer, OUTPUT_BUFFER_SIZE, "Dropped %u log records, the ring buffer was full\n", SDL_GetAtomicU32(&dropped));
+		writeOutput();
+	}
+
+	if (logFile != NULL) {
+		SDL_CloseIO(logFile);
+		logFile = NULL;
+	}
+}
+
+void eng_setLogLevel(ENG_LOG_LEVEL level) {
+	minimumLevel = level;
+}
+
+ENG_LOG_LEVEL eng_getLogLevel() {
+	return minimumLevel;
+}
+
+void eng_setLogCategoryEnabled(ENG_LOG_CATEGORY category, bool enabled) {
+	if (category >= ENG_LOG_CATEGORY_COUNT) {
+		eng_setError(INVALID_TYPE);
+		return;
+	}
+
+	categoryEnabled[category] = enabled;
+}
+
+bool eng_isLogging(ENG_LOG_LEVEL level, ENG_LOG_CATEGORY category) {
+	return level >= minimumLevel && level < ENG_LOG_NONE && category < ENG_LOG_CATEGORY_COUNT
+		&& categoryEnabled[category] && SDL_GetAtomicInt(&running);
+}
+
+void eng_log(ENG_LOG_LEVEL level, ENG_LOG_CATEGORY category, const char *format, ...) {
+	if (!eng_isLogging(level, category)) {
+		return;
+	}
+
+	uint32_t position = SDL_GetAtomicU32(&writePosition);
+	LogRecord *record;
+	while (true) {
+		record = &records[position & (ENG_LOG_CAPACITY - 1)];
+		int32_t difference = (int32_t)(SDL_GetAtomicU32(&record->sequence) - position);
+
+		if (difference == 0) {
+			if (SDL_CompareAndSwapAtomicU32(&writePosition, position, position + 1)) {
+				break;
+			}
+			position = SDL_GetAtomicU32(&writePosition);
+		} else if (difference < 0) {
+			// The flush thread hasn't caught up, dropping is better than stalling the frame
+			uint32_t count;
+			do {
+				count = SDL_GetAtomicU32(&dropped);
+			} while (!SDL_CompareAndSwapAtomicU32(&dropped, count, count + 1));
+			return;
+		} else {
+			position = SDL_GetAtomicU32(&writePosition);
+		}
+	}
+
+	record->level = level;
+	record->category = category;
+	record->timeNS = SDL_GetTicksNS();
+
+	va_list args;
+	va_start(args, format);
+	SDL_vsnprintf(record->message, ENG_LOG_MESSAGE_LENGTH, format, args);
+	va_end(args);
+
+	SDL_SetAtomicU32(&record->sequence, position + 1);
+}
+
+uint32_t eng_getDroppedLogs() {
+	return SDL_GetAtomicU32(&dropped);
+}
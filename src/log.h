@@ -0,0 +1,71 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "engine.h"
+
+/*
+* Asynchronous logging, eng_log formats the message into a lock-free ring buffer and a background thread writes it to the console or a file.
+*
+* eng_log never waits, if the ring buffer is full the record is dropped and counted so it can be reported by eng_getDroppedLogs.
+* It's safe to call from any thread. eng_init starts logging to the console at ENG_LOG_DEBUG when debug is enabled.
+*/
+
+#define ENG_LOG_CAPACITY 1024 // Must be a power of two
+#define ENG_LOG_MESSAGE_LENGTH 232
+
+typedef enum {
+	ENG_LOG_TRACE,
+	ENG_LOG_DEBUG,
+	ENG_LOG_INFO,
+	ENG_LOG_WARN,
+	ENG_LOG_ERROR,
+	ENG_LOG_NONE,
+} ENG_LOG_LEVEL;
+
+typedef enum {
+	ENG_LOG_CORE,
+	ENG_LOG_QUEUE,
+	ENG_LOG_RENDER,
+	ENG_LOG_ASSET,
+	ENG_LOG_INPUT,
+	ENG_LOG_GAME,
+	ENG_LOG_AUDIO,
+	ENG_LOG_CATEGORY_COUNT,
+} ENG_LOG_CATEGORY;
+
+/*
+* Starts the flush thread, records are written to path or to the console if path is NULL.
+* Calling this again while logging restarts it with the new destination
+*/
+ENG_RESULT eng_startLogging(const char *path);
+
+/*
+* Writes every record still in the ring buffer and stops the flush thread, eng_quit calls this last
+*/
+void eng_stopLogging();
+
+/*
+* Records below this level are thrown away before they are formatted
+*/
+void eng_setLogLevel(ENG_LOG_LEVEL level);
+
+ENG_LOG_LEVEL eng_getLogLevel();
+
+void eng_setLogCategoryEnabled(ENG_LOG_CATEGORY category, bool enabled);
+
+/*
+* Returns weather a record with this level and category would be written, useful to skip building expensive messages
+*/
+bool eng_isLogging(ENG_LOG_LEVEL level, ENG_LOG_CATEGORY category);
+
+/*
+* Adds a printf style record to the log, messages longer than ENG_LOG_MESSAGE_LENGTH are cut off
+*/
+void eng_log(ENG_LOG_LEVEL level, ENG_LOG_CATEGORY category, const char *format, ...);
+
+/*
+* Returns how many records were dropped because the ring buffer was full
+*/
+uint32_t eng_getDroppedLogs();
+
+#endif
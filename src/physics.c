@@ -0,0 +1,706 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <float.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "handle.h"
+#include "physics.h"
+
+// Gap kept between touching boxes so a body resting on something isn't counted as overlapping it
+#define SKIN 0.001f
+#define DEFAULT_MAX_FALL_SPEED 2000.0f
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+// Bytes taken by one body across every array, for memory accounting
+#define BODY_BYTES (6 * sizeof(float) + 2 * sizeof(uint8_t) + 2 * sizeof(eng_Body) + sizeof(eng_Handle) + sizeof(uint32_t))
+
+static bool reserveBodies(eng_PhysicsWorld *world, uint32_t capacity) {
+	if (capacity <= world->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&world->x, capacity, sizeof(float))
+		|| !growArray((void **)&world->y, capacity, sizeof(float))
+		|| !growArray((void **)&world->h, capacity, sizeof(float))
+		|| !growArray((void **)&world->w, capacity, sizeof(float))
+		|| !growArray((void **)&world->velocityX, capacity, sizeof(float))
+		|| !growArray((void **)&world->velocityY, capacity, sizeof(float))
+		|| !growArray((void **)&world->flags, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&world->contacts, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&world->ground, capacity, sizeof(eng_Body))
+		|| !growArray((void **)&world->object, capacity, sizeof(eng_Handle))
+		|| !growArray((void **)&world->queryStamp, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&world->found, capacity, sizeof(eng_Body))) {
+		return false;
+	}
+	eng_trackMemory(ENG_MEMORY_POOLS, (int64_t)(capacity - world->capacity) * BODY_BYTES, world->capacity == 0 ? 1 : 0);
+	world->capacity = capacity;
+
+	return true;
+}
+
+static bool isBody(eng_PhysicsWorld *world, eng_Body body) {
+	return world != NULL && body < world->count;
+}
+
+eng_PhysicsWorld *eng_createPhysicsWorld(float gravity, float cellSize, uint32_t capacity) {
+	eng_PhysicsWorld *world = (eng_PhysicsWorld *)calloc(1, sizeof(eng_PhysicsWorld));
+	if (world == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	if (!reserveBodies(world, capacity == 0 ? 64 : capacity)) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroyPhysicsWorld(world);
+		return NULL;
+	}
+	world->gravity = gravity;
+	world->maxFallSpeed = DEFAULT_MAX_FALL_SPEED;
+	world->cellSize = cellSize > 0 ? cellSize : 64.0f;
+
+	return world;
+}
+
+eng_TileMap *eng_createTileMap(uint32_t width, uint32_t height, float tileSize, float x, float y) {
+	if (width == 0 || height == 0 || tileSize <= 0) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	eng_TileMap *map = (eng_TileMap *)malloc(sizeof(eng_TileMap));
+	if (map == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	*map = (eng_TileMap) {
+		.tiles = (uint8_t *)calloc((size_t)width * height, sizeof(uint8_t)),
+		.width = width,
+		.height = height,
+		.tileSize = tileSize,
+		.x = x,
+		.y = y,
+	};
+	if (map->tiles == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		free(map);
+		return NULL;
+	}
+
+	return map;
+}
+
+void eng_setTile(eng_TileMap *map, uint32_t column, uint32_t row, ENG_TILE tile) {
+	if (map == NULL || column >= map->width || row >= map->height) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	map->tiles[row * map->width + column] = tile;
+}
+
+ENG_TILE eng_getTile(eng_TileMap *map, int column, int row) {
+	if (map == NULL || column < 0 || row < 0 || (uint32_t)column >= map->width || (uint32_t)row >= map->height) {
+		return ENG_TILE_EMPTY;
+	}
+
+	return map->tiles[row * map->width + column];
+}
+
+void eng_destroyTileMap(eng_TileMap *map) {
+	if (map == NULL) {
+		return;
+	}
+
+	free(map->tiles);
+	free(map);
+}
+
+void eng_setPhysicsTileMap(eng_PhysicsWorld *world, eng_TileMap *map) {
+	if (world == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	world->map = map;
+}
+
+eng_Body eng_createBody(eng_PhysicsWorld *world, float x, float y, float h, float w, ENG_BODY_FLAGS flags) {
+	if (world == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_BODY;
+	}
+
+	if (world->count == world->capacity && !reserveBodies(world, world->capacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_NO_BODY;
+	}
+
+	eng_Body body = world->count++;
+	world->x[body] = x;
+	world->y[body] = y;
+	world->h[body] = h;
+	world->w[body] = w;
+	world->velocityX[body] = 0;
+	world->velocityY[body] = 0;
+	world->flags[body] = flags;
+	world->contacts[body] = 0;
+	world->ground[body] = ENG_NO_BODY;
+	world->object[body] = ENG_INVALID_HANDLE;
+	world->queryStamp[body] = 0;
+
+	return body;
+}
+
+void eng_setBodyVelocity(eng_PhysicsWorld *world, eng_Body body, float velocityX, float velocityY) {
+	if (!isBody(world, body)) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	world->velocityX[body] = velocityX;
+	world->velocityY[body] = velocityY;
+}
+
+void eng_setBodyEnabled(eng_PhysicsWorld *world, eng_Body body, bool enabled) {
+	if (!isBody(world, body)) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	if (enabled) {
+		world->flags[body] &= ~ENG_BODY_DISABLED;
+	} else {
+		world->flags[body] |= ENG_BODY_DISABLED;
+		world->contacts[body] = 0;
+		world->ground[body] = ENG_NO_BODY;
+	}
+}
+
+ENG_RESULT eng_bindBody(eng_PhysicsWorld *world, eng_Body body, void *object, Type type) {
+	if (!isBody(world, body) || object == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	switch (type) {
+		case TYPE_RECT:
+			world->object[body] = ((eng_Rect *)object)->handle;
+			break;
+		case TYPE_TEXTURE:
+			world->object[body] = ((eng_Texture *)object)->handle;
+			break;
+		case TYPE_TEXT:
+			world->object[body] = ((eng_Text *)object)->handle;
+			break;
+		default:
+			return eng_setError(INVALID_TYPE);
+	}
+
+	return SUCCESS;
+}
+
+bool eng_isBodyGrounded(eng_PhysicsWorld *world, eng_Body body) {
+	return isBody(world, body) && (world->contacts[body] & ENG_CONTACT_DOWN);
+}
+
+bool eng_sweepBox(float x, float y, float h, float w, float moveX, float moveY,
+	float otherX, float otherY, float otherH, float otherW, float *time, float *normalX, float *normalY) {
+	float entryX, entryY, exitX, exitY;
+
+	// Distances to where the boxes start and stop touching on each axis
+	if (moveX > 0) {
+		entryX = otherX - (x + w);
+		exitX = (otherX + otherW) - x;
+	} else {
+		entryX = x - (otherX + otherW);
+		exitX = (x + w) - otherX;
+	}
+	if (moveY > 0) {
+		entryY = otherY - (y + h);
+		exitY = (otherY + otherH) - y;
+	} else {
+		entryY = y - (otherY + otherH);
+		exitY = (y + h) - otherY;
+	}
+
+	float entryTimeX = moveX != 0 ? entryX / SDL_fabsf(moveX) : (entryX < 0 && exitX > 0 ? -FLT_MAX : FLT_MAX);
+	float exitTimeX = moveX != 0 ? exitX / SDL_fabsf(moveX) : FLT_MAX;
+	float entryTimeY = moveY != 0 ? entryY / SDL_fabsf(moveY) : (entryY < 0 && exitY > 0 ? -FLT_MAX : FLT_MAX);
+	float exitTimeY = moveY != 0 ? exitY / SDL_fabsf(moveY) : FLT_MAX;
+
+	float entryTime = SDL_max(entryTimeX, entryTimeY);
+	float exitTime = SDL_min(exitTimeX, exitTimeY);
+	if (entryTime > exitTime || entryTime > 1.0f || exitTime < 0) {
+		return false;
+	}
+
+	float hitX = 0;
+	float hitY = 0;
+	if (entryTimeX > entryTimeY) {
+		hitX = moveX > 0 ? -1.0f : 1.0f;
+	} else {
+		hitY = moveY > 0 ? -1.0f : 1.0f;
+	}
+
+	if (time != NULL) {
+		*time = SDL_max(entryTime, 0.0f);
+	}
+	if (normalX != NULL) {
+		*normalX = hitX;
+	}
+	if (normalY != NULL) {
+		*normalY = hitY;
+	}
+
+	return true;
+}
+
+static int toCell(eng_PhysicsWorld *world, float position) {
+	return (int)SDL_floorf(position / world->cellSize);
+}
+
+static uint32_t hashCell(int column, int row) {
+	return ((uint32_t)column * 73856093u ^ (uint32_t)row * 19349663u) & (ENG_PHYSICS_BUCKETS - 1);
+}
+
+// Counts every body's cells, then fills each bucket from its end so bucketStart finishes at the start of every bucket
+static bool buildBuckets(eng_PhysicsWorld *world) {
+	memset(world->bucketStart, 0, sizeof(world->bucketStart));
+
+	uint32_t total = 0;
+	for (eng_Body body = 0; body < world->count; body++) {
+		if (world->flags[body] & ENG_BODY_DISABLED) {
+			continue;
+		}
+		for (int row = toCell(world, world->y[body]); row <= toCell(world, world->y[body] + world->h[body]); row++) {
+			for (int column = toCell(world, world->x[body]); column <= toCell(world, world->x[body] + world->w[body]); column++) {
+				world->bucketStart[hashCell(column, row)]++;
+				total++;
+			}
+		}
+	}
+
+	if (total > world->entryCapacity) {
+		uint32_t capacity = SDL_max(total, world->entryCapacity * 2);
+		if (!growArray((void **)&world->entries, capacity, sizeof(eng_Body))) {
+			memset(world->bucketStart, 0, sizeof(world->bucketStart));
+			return false;
+		}
+		eng_trackMemory(ENG_MEMORY_POOLS, (int64_t)(capacity - world->entryCapacity) * sizeof(eng_Body), 0);
+		world->entryCapacity = capacity;
+	}
+
+	for (uint32_t i = 1; i < ENG_PHYSICS_BUCKETS; i++) {
+		world->bucketStart[i] += world->bucketStart[i - 1];
+	}
+	world->bucketStart[ENG_PHYSICS_BUCKETS] = total;
+
+	for (eng_Body body = 0; body < world->count; body++) {
+		if (world->flags[body] & ENG_BODY_DISABLED) {
+			continue;
+		}
+		for (int row = toCell(world, world->y[body]); row <= toCell(world, world->y[body] + world->h[body]); row++) {
+			for (int column = toCell(world, world->x[body]); column <= toCell(world, world->x[body] + world->w[body]); column++) {
+				world->entries[--world->bucketStart[hashCell(column, row)]] = body;
+			}
+		}
+	}
+
+	return true;
+}
+
+// Writes every body in the cells touching the box into world->found once, returns how many there are
+static uint32_t findBodies(eng_PhysicsWorld *world, float left, float top, float right, float bottom, bool solidOnly) {
+	if (++world->queryId == 0) {
+		memset(world->queryStamp, 0, world->count * sizeof(uint32_t));
+		world->queryId = 1;
+	}
+
+	uint32_t count = 0;
+	for (int row = toCell(world, top); row <= toCell(world, bottom); row++) {
+		for (int column = toCell(world, left); column <= toCell(world, right); column++) {
+			uint32_t bucket = hashCell(column, row);
+			for (uint32_t i = world->bucketStart[bucket]; i < world->bucketStart[bucket + 1]; i++) {
+				eng_Body body = world->entries[i];
+				if (world->queryStamp[body] == world->queryId || (solidOnly && !(world->flags[body] & ENG_BODY_SOLID))) {
+					continue;
+				}
+				world->queryStamp[body] = world->queryId;
+				world->found[count++] = body;
+			}
+		}
+	}
+
+	return count;
+}
+
+static int tileIndex(float position, float start, float tileSize) {
+	return (int)SDL_floorf((position - start) / tileSize);
+}
+
+// Tiles in the lowest row the body overlaps are stepped over while walking if their top is close to the body's feet, this lets a body walk off the top of a slope
+static float sweepTilesX(eng_PhysicsWorld *world, eng_Body body, float moveX, bool grounded) {
+	eng_TileMap *map = world->map;
+	if (map == NULL || moveX == 0) {
+		return moveX;
+	}
+
+	float size = map->tileSize;
+	float top = world->y[body];
+	float bottom = top + world->h[body];
+	int firstRow = tileIndex(top + SKIN, map->y, size);
+	int lastRow = (int)SDL_ceilf((bottom - SKIN - map->y) / size) - 1;
+
+	if (moveX > 0) {
+		float edge = world->x[body] + world->w[body];
+		int first = (int)SDL_ceilf((edge - SKIN - map->x) / size);
+		int last = (int)SDL_ceilf((edge + moveX - map->x) / size) - 1;
+		for (int column = first; column <= last; column++) {
+			for (int row = firstRow; row <= lastRow; row++) {
+				float rowTop = map->y + row * size;
+				if (eng_getTile(map, column, row) == ENG_TILE_SOLID && !(grounded && row == lastRow && bottom - rowTop <= size / 2)) {
+					return SDL_max(map->x + column * size - edge, 0.0f);
+				}
+			}
+		}
+	} else {
+		float edge = world->x[body];
+		int first = tileIndex(edge + SKIN, map->x, size) - 1;
+		int last = tileIndex(edge + moveX, map->x, size);
+		for (int column = first; column >= last; column--) {
+			for (int row = firstRow; row <= lastRow; row++) {
+				float rowTop = map->y + row * size;
+				if (eng_getTile(map, column, row) == ENG_TILE_SOLID && !(grounded && row == lastRow && bottom - rowTop <= size / 2)) {
+					return SDL_min(map->x + (column + 1) * size - edge, 0.0f);
+				}
+			}
+		}
+	}
+
+	return moveX;
+}
+
+static float sweepTilesY(eng_PhysicsWorld *world, eng_Body body, float moveY) {
+	eng_TileMap *map = world->map;
+	if (map == NULL || moveY == 0) {
+		return moveY;
+	}
+
+	float size = map->tileSize;
+	float left = world->x[body];
+	float right = left + world->w[body];
+	int firstColumn = tileIndex(left + SKIN, map->x, size);
+	int lastColumn = (int)SDL_ceilf((right - SKIN - map->x) / size) - 1;
+
+	if (moveY > 0) {
+		float edge = world->y[body] + world->h[body];
+		int first = (int)SDL_ceilf((edge - SKIN - map->y) / size);
+		int last = (int)SDL_ceilf((edge + moveY - map->y) / size) - 1;
+		for (int row = first; row <= last; row++) {
+			for (int column = firstColumn; column <= lastColumn; column++) {
+				// One-way tiles in this range are all below the body's feet so they block too
+				ENG_TILE tile = eng_getTile(map, column, row);
+				if (tile == ENG_TILE_SOLID || tile == ENG_TILE_ONE_WAY) {
+					return SDL_max(map->y + row * size - edge, 0.0f);
+				}
+			}
+		}
+	} else {
+		float edge = world->y[body];
+		int first = tileIndex(edge + SKIN, map->y, size) - 1;
+		int last = tileIndex(edge + moveY, map->y, size);
+		for (int row = first; row >= last; row--) {
+			for (int column = firstColumn; column <= lastColumn; column++) {
+				if (eng_getTile(map, column, row) == ENG_TILE_SOLID) {
+					return SDL_min(map->y + (row + 1) * size - edge, 0.0f);
+				}
+			}
+		}
+	}
+
+	return moveY;
+}
+
+static float sweepBodiesX(eng_PhysicsWorld *world, eng_Body body, float moveX, uint32_t found) {
+	float top = world->y[body];
+	float bottom = top + world->h[body];
+
+	for (uint32_t i = 0; i < found; i++) {
+		eng_Body other = world->found[i];
+		if (other == body || (world->flags[other] & ENG_BODY_ONE_WAY)
+			|| world->y[other] >= bottom - SKIN || world->y[other] + world->h[other] <= top + SKIN) {
+			continue;
+		}
+
+		if (moveX > 0) {
+			float distance = world->x[other] - (world->x[body] + world->w[body]);
+			if (distance >= -SKIN && distance < moveX) {
+				moveX = SDL_max(distance, 0.0f);
+			}
+		} else if (moveX < 0) {
+			float distance = world->x[other] + world->w[other] - world->x[body];
+			if (distance <= SKIN && distance > moveX) {
+				moveX = SDL_min(distance, 0.0f);
+			}
+		}
+	}
+
+	return moveX;
+}
+
+static float sweepBodiesY(eng_PhysicsWorld *world, eng_Body body, float moveY, uint32_t found, eng_Body *ground) {
+	float left = world->x[body];
+	float right = left + world->w[body];
+
+	for (uint32_t i = 0; i < found; i++) {
+		eng_Body other = world->found[i];
+		if (other == body || world->x[other] >= right - SKIN || world->x[other] + world->w[other] <= left + SKIN) {
+			continue;
+		}
+
+		if (moveY > 0) {
+			float distance = world->y[other] - (world->y[body] + world->h[body]);
+			if (distance >= -SKIN && distance <= moveY) {
+				moveY = SDL_max(distance, 0.0f);
+				*ground = other;
+			}
+		} else if (moveY < 0 && !(world->flags[other] & ENG_BODY_ONE_WAY)) {
+			float distance = world->y[other] + world->h[other] - world->y[body];
+			if (distance <= SKIN && distance > moveY) {
+				moveY = SDL_min(distance, 0.0f);
+			}
+		}
+	}
+
+	return moveY;
+}
+
+// Finds the floor under the point, a slope's floor is the height of the slope at x
+static bool findFloor(eng_TileMap *map, float x, float bottom, float *floor) {
+	float size = map->tileSize;
+	int column = tileIndex(x, map->x, size);
+	int row = tileIndex(bottom - SKIN, map->y, size);
+	float along = (x - (map->x + column * size)) / size;
+
+	for (int i = row; i <= row + 1; i++) {
+		float top = map->y + i * size;
+		switch (eng_getTile(map, column, i)) {
+			case ENG_TILE_SLOPE_UP:
+				*floor = top + size * (1.0f - along);
+				return true;
+			case ENG_TILE_SLOPE_DOWN:
+				*floor = top + size * along;
+				return true;
+			case ENG_TILE_SOLID:
+				*floor = top;
+				return true;
+			case ENG_TILE_ONE_WAY:
+				if (i == row + 1) {
+					*floor = top;
+					return true;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	return false;
+}
+
+// Lifts a body that sank into a slope back onto it and keeps a walking body on the slope when it goes down hill
+static void followFloor(eng_PhysicsWorld *world, eng_Body body, bool wasGrounded) {
+	eng_TileMap *map = world->map;
+	if (map == NULL || world->velocityY[body] < 0) {
+		return;
+	}
+
+	float bottom = world->y[body] + world->h[body];
+	float floor;
+	if (!findFloor(map, world->x[body] + world->w[body] / 2, bottom, &floor)) {
+		return;
+	}
+
+	float depth = bottom - floor;
+	float step = map->tileSize / 2;
+	if ((depth > 0 && depth <= (wasGrounded ? step : map->tileSize)) || (wasGrounded && depth < 0 && -depth <= step)) {
+		world->y[body] = floor - world->h[body];
+		world->velocityY[body] = 0;
+		world->contacts[body] |= ENG_CONTACT_DOWN;
+		world->ground[body] = ENG_NO_BODY;
+	}
+}
+
+static void moveBody(eng_PhysicsWorld *world, eng_Body body, float deltaSeconds) {
+	bool wasGrounded = world->contacts[body] & ENG_CONTACT_DOWN;
+	eng_Body ground = world->ground[body];
+
+	// Riding a moving platform, the platform already moved this step
+	if (ground != ENG_NO_BODY && (world->flags[ground] & ENG_BODY_KINEMATIC) && !(world->flags[ground] & ENG_BODY_DISABLED)) {
+		world->x[body] += world->velocityX[ground] * deltaSeconds;
+		world->y[body] += world->velocityY[ground] * deltaSeconds;
+	}
+
+	world->velocityY[body] = SDL_min(world->velocityY[body] + world->gravity * deltaSeconds, world->maxFallSpeed);
+	float moveX = world->velocityX[body] * deltaSeconds;
+	float moveY = world->velocityY[body] * deltaSeconds;
+	world->contacts[body] = 0;
+	world->ground[body] = ENG_NO_BODY;
+
+	// Only the solid bodies near the whole path are checked
+	float x = world->x[body];
+	float y = world->y[body];
+	uint32_t found = findBodies(world, SDL_min(x, x + moveX), SDL_min(y, y + moveY),
+		SDL_max(x, x + moveX) + world->w[body], SDL_max(y, y + moveY) + world->h[body], true);
+
+	float movedX = sweepBodiesX(world, body, sweepTilesX(world, body, moveX, wasGrounded), found);
+	world->x[body] += movedX;
+	if (movedX != moveX) {
+		world->contacts[body] |= moveX > 0 ? ENG_CONTACT_RIGHT : ENG_CONTACT_LEFT;
+		world->velocityX[body] = 0;
+	}
+
+	eng_Body hitBody = ENG_NO_BODY;
+	float movedY = sweepTilesY(world, body, moveY);
+	float movedBodyY = sweepBodiesY(world, body, movedY, found, &hitBody);
+	world->y[body] += movedBodyY;
+	if (movedBodyY != moveY) {
+		world->contacts[body] |= moveY > 0 ? ENG_CONTACT_DOWN : ENG_CONTACT_UP;
+		world->velocityY[body] = 0;
+		if (moveY > 0) {
+			world->ground[body] = hitBody;
+		}
+	}
+
+	if (world->ground[body] == ENG_NO_BODY) {
+		followFloor(world, body, wasGrounded);
+	}
+}
+
+static void writeObject(eng_PhysicsWorld *world, eng_Body body) {
+	Type type;
+	void *object = eng_getObject(world->object[body], &type);
+	if (object == NULL) {
+		world->object[body] = ENG_INVALID_HANDLE;
+		return;
+	}
+
+	float *x;
+	float *y;
+	switch (type) {
+		case TYPE_RECT:
+			x = &((eng_Rect *)object)->x;
+			y = &((eng_Rect *)object)->y;
+			break;
+		case TYPE_TEXTURE:
+			x = &((eng_Texture *)object)->x;
+			y = &((eng_Texture *)object)->y;
+			break;
+		case TYPE_TEXT:
+			x = &((eng_Text *)object)->x;
+			y = &((eng_Text *)object)->y;
+			break;
+		default:
+			return;
+	}
+
+	// Bodies at rest leave pick indexes alone
+	if (*x != world->x[body] || *y != world->y[body]) {
+		*x = world->x[body];
+		*y = world->y[body];
+		eng_markObjectMoved(world->object[body]);
+	}
+}
+
+void eng_stepPhysics(eng_PhysicsWorld *world, float deltaSeconds) {
+	if (world == NULL || deltaSeconds <= 0) {
+		return;
+	}
+
+	// Moving platforms go first so bodies collide with where they are now
+	for (eng_Body body = 0; body < world->count; body++) {
+		if ((world->flags[body] & (ENG_BODY_KINEMATIC | ENG_BODY_DISABLED)) == ENG_BODY_KINEMATIC) {
+			world->x[body] += world->velocityX[body] * deltaSeconds;
+			world->y[body] += world->velocityY[body] * deltaSeconds;
+		}
+	}
+
+	if (!buildBuckets(world)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return;
+	}
+
+	for (eng_Body body = 0; body < world->count; body++) {
+		if (!(world->flags[body] & (ENG_BODY_SOLID | ENG_BODY_KINEMATIC | ENG_BODY_DISABLED))) {
+			moveBody(world, body, deltaSeconds);
+		}
+	}
+
+	// Rebuilt so eng_queryBodies sees where the bodies ended up
+	if (!buildBuckets(world)) {
+		eng_setError(FAILED_TO_MALLOC);
+	}
+
+	for (eng_Body body = 0; body < world->count; body++) {
+		if (world->object[body] != ENG_INVALID_HANDLE) {
+			writeObject(world, body);
+		}
+	}
+}
+
+uint32_t eng_queryBodies(eng_PhysicsWorld *world, float x, float y, float h, float w, eng_Body *bodies, uint32_t maxBodies) {
+	if (world == NULL || bodies == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return 0;
+	}
+
+	uint32_t found = findBodies(world, x, y, x + w, y + h, false);
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < found && count < maxBodies; i++) {
+		eng_Body body = world->found[i];
+		if (!(world->flags[body] & ENG_BODY_DISABLED) && world->x[body] < x + w && world->x[body] + world->w[body] > x
+			&& world->y[body] < y + h && world->y[body] + world->h[body] > y) {
+			bodies[count++] = body;
+		}
+	}
+
+	return count;
+}
+
+void eng_destroyPhysicsWorld(eng_PhysicsWorld *world) {
+	if (world == NULL) {
+		return;
+	}
+
+	if (world->capacity > 0) {
+		eng_trackMemory(ENG_MEMORY_POOLS, -(int64_t)(world->capacity * BODY_BYTES + world->entryCapacity * sizeof(eng_Body)), -1);
+	}
+	free(world->x);
+	free(world->y);
+	free(world->h);
+	free(world->w);
+	free(world->velocityX);
+	free(world->velocityY);
+	free(world->flags);
+	free(world->contacts);
+	free(world->ground);
+	free(world->object);
+	free(world->queryStamp);
+	free(world->found);
+	free(world->entries);
+	free(world);
+}
@@ -0,0 +1,141 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "engine.h"
+
+/*
+* Kinematic platformer physics, bodies are axis aligned boxes that move by their velocity and stop at tiles and solid bodies.
+*
+* Every step moves a body along x and then along y and each move is swept, the body stops at the first tile or solid body in its path
+* no matter how far it travels in one step so fast objects can't pass through thin platforms. One-way tiles and bodies only block from above,
+* slope tiles are walked up and down by keeping the bottom middle of the body on the slope.
+*
+* Bodies are kept in a spatial hash rebuilt every step so a body only checks what is near its path. Dynamic bodies don't collide with
+* each other, use eng_queryBodies to find what overlaps. Bodies live as long as the world, disable them instead of removing them.
+*/
+
+#define ENG_PHYSICS_BUCKETS 4096 // Must be a power of two
+#define ENG_NO_BODY UINT32_MAX
+
+typedef uint32_t eng_Body;
+
+typedef enum {
+	ENG_TILE_EMPTY,
+	ENG_TILE_SOLID,
+	ENG_TILE_ONE_WAY,
+	ENG_TILE_SLOPE_UP, // Floor rises from the bottom left corner to the top right corner
+	ENG_TILE_SLOPE_DOWN, // Floor falls from the top left corner to the bottom right corner
+} ENG_TILE;
+
+typedef enum {
+	ENG_BODY_DYNAMIC = 0, // Falls with gravity and collides with tiles and solid bodies
+	ENG_BODY_SOLID = 1 << 0, // Blocks dynamic bodies
+	ENG_BODY_ONE_WAY = 1 << 1, // Combined with ENG_BODY_SOLID, only blocks from above
+	ENG_BODY_KINEMATIC = 1 << 2, // Moves by its velocity ignoring gravity and collisions, carries bodies standing on it
+	ENG_BODY_DISABLED = 1 << 3,
+} ENG_BODY_FLAGS;
+
+typedef enum {
+	ENG_CONTACT_LEFT = 1 << 0,
+	ENG_CONTACT_RIGHT = 1 << 1,
+	ENG_CONTACT_UP = 1 << 2,
+	ENG_CONTACT_DOWN = 1 << 3,
+} ENG_CONTACT;
+
+typedef struct {
+	uint8_t *tiles; // width * height ENG_TILE values, row by row
+	uint32_t width;
+	uint32_t height;
+	float tileSize;
+	float x; // Position of the top left corner of the map
+	float y;
+} eng_TileMap;
+
+typedef struct {
+	float *x;
+	float *y;
+	float *h;
+	float *w;
+	float *velocityX;
+	float *velocityY;
+	uint8_t *flags;
+	uint8_t *contacts; // ENG_CONTACT flags from the last step
+	eng_Body *ground; // The body this one is standing on or ENG_NO_BODY
+	eng_Handle *object; // Object that follows the body
+	uint32_t count;
+	uint32_t capacity;
+
+	eng_TileMap *map;
+	float gravity;
+	float maxFallSpeed;
+	float cellSize;
+
+	// Spatial hash, bucketStart[i] to bucketStart[i + 1] are the entries of bucket i
+	uint32_t bucketStart[ENG_PHYSICS_BUCKETS + 1];
+	eng_Body *entries;
+	uint32_t entryCapacity;
+	uint32_t *queryStamp;
+	uint32_t queryId;
+	eng_Body *found;
+} eng_PhysicsWorld;
+
+/*
+* cellSize is the size of a spatial hash cell, around twice the size of a typical body works well. gravity is in pixels per second squared
+*/
+eng_PhysicsWorld *eng_createPhysicsWorld(float gravity, float cellSize, uint32_t capacity);
+
+/*
+* Makes a width by height map of empty tiles, the map is drawn by the game, this only handles collisions
+*/
+eng_TileMap *eng_createTileMap(uint32_t width, uint32_t height, float tileSize, float x, float y);
+
+void eng_setTile(eng_TileMap *map, uint32_t column, uint32_t row, ENG_TILE tile);
+
+ENG_TILE eng_getTile(eng_TileMap *map, int column, int row);
+
+void eng_destroyTileMap(eng_TileMap *map);
+
+/*
+* Sets the tiles bodies collide with, pass NULL for none. The world doesn't own the map
+*/
+void eng_setPhysicsTileMap(eng_PhysicsWorld *world, eng_TileMap *map);
+
+/*
+* Adds a body, returns ENG_NO_BODY if it failed
+*/
+eng_Body eng_createBody(eng_PhysicsWorld *world, float x, float y, float h, float w, ENG_BODY_FLAGS flags);
+
+void eng_setBodyVelocity(eng_PhysicsWorld *world, eng_Body body, float velocityX, float velocityY);
+
+void eng_setBodyEnabled(eng_PhysicsWorld *world, eng_Body body, bool enabled);
+
+/*
+* Copies the body's position into a rect, image or text after every step
+*/
+ENG_RESULT eng_bindBody(eng_PhysicsWorld *world, eng_Body body, void *object, Type type);
+
+/*
+* Returns weather the body is standing on a tile or a solid body
+*/
+bool eng_isBodyGrounded(eng_PhysicsWorld *world, eng_Body body);
+
+/*
+* Moves every body by its velocity over deltaSeconds and resolves the collisions
+*/
+void eng_stepPhysics(eng_PhysicsWorld *world, float deltaSeconds);
+
+/*
+* Writes up to maxBodies bodies overlapping the box into bodies and returns how many were found, the results are from the last step
+*/
+uint32_t eng_queryBodies(eng_PhysicsWorld *world, float x, float y, float h, float w, eng_Body *bodies, uint32_t maxBodies);
+
+/*
+* Sweeps a box moving by moveX and moveY against a still box. Returns weather they hit, time is the fraction of the move before the hit
+* and normalX and normalY point away from the surface that was hit. Boxes that already overlap hit at time 0
+*/
+bool eng_sweepBox(float x, float y, float h, float w, float moveX, float moveY,
+	float otherX, float otherY, float otherH, float otherW, float *time, float *normalX, float *normalY);
+
+void eng_destroyPhysicsWorld(eng_PhysicsWorld *world);
+
+#endif
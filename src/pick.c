@@ -0,0 +1,286 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "pick.h"
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+static bool reserveItems(eng_PickIndex *index, uint32_t capacity) {
+	if (capacity <= index->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&index->x, capacity, sizeof(float))
+		|| !growArray((void **)&index->y, capacity, sizeof(float))
+		|| !growArray((void **)&index->h, capacity, sizeof(float))
+		|| !growArray((void **)&index->w, capacity, sizeof(float))
+		|| !growArray((void **)&index->object, capacity, sizeof(void *))
+		|| !growArray((void **)&index->type, capacity, sizeof(Type))) {
+		return false;
+	}
+	index->capacity = capacity;
+
+	return true;
+}
+
+eng_PickIndex *eng_createPickIndex() {
+	eng_PickIndex *index = (eng_PickIndex *)calloc(1, sizeof(eng_PickIndex));
+	if (index == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	index->cellStart = (uint32_t *)calloc(ENG_PICK_MAX_CELLS * ENG_PICK_MAX_CELLS + 1, sizeof(uint32_t));
+	if (index->cellStart == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		free(index);
+		return NULL;
+	}
+
+	return index;
+}
+
+ENG_RESULT eng_addPickQueue(eng_PickIndex *index, RenderQueue *queue, int layer) {
+	if (index == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (index->queueCount == index->queueCapacity) {
+		uint32_t newCapacity = index->queueCapacity == 0 ? 4 : index->queueCapacity * 2;
+		if (!growArray((void **)&index->queues, newCapacity, sizeof(eng_PickQueue))) {
+			return eng_setError(FAILED_TO_MALLOC);
+		}
+		index->queueCapacity = newCapacity;
+	}
+
+	// Kept sorted by layer, queues on the same layer stay in the order they were added
+	uint32_t i = index->queueCount++;
+	while (i > 0 && index->queues[i - 1].layer > layer) {
+		index->queues[i] = index->queues[i - 1];
+		i--;
+	}
+	index->queues[i] = (eng_PickQueue) {
+		.queue = queue,
+		.layer = layer,
+	};
+	index->version = 0;
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_removePickQueue(eng_PickIndex *index, RenderQueue *queue) {
+	if (index == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	for (uint32_t i = 0; i < index->queueCount; i++) {
+		if (index->queues[i].queue == queue) {
+			memmove(&index->queues[i], &index->queues[i + 1], (index->queueCount - i - 1) * sizeof(eng_PickQueue));
+			index->queueCount--;
+			index->version = 0;
+			return SUCCESS;
+		}
+	}
+
+	return eng_setError(QUEUE_WAS_NULL);
+}
+
+static bool addItems(eng_PickIndex *index, RenderQueue *queue) {
+	for (RenderQueue *node = queue; node != NULL; node = node->pNext) {
+		if (node->data == NULL || (node->type != TYPE_RECT && node->type != TYPE_TEXTURE && node->type != TYPE_TEXT)) {
+			continue;
+		}
+
+		eng_Rect rect = eng_extractRectFromObject(node->data, node->type);
+		if (rect.w <= 0 || rect.h <= 0) {
+			continue;
+		}
+
+		if (index->count == index->capacity && !reserveItems(index, index->capacity == 0 ? 64 : index->capacity * 2)) {
+			return false;
+		}
+
+		uint32_t i = index->count++;
+		index->x[i] = rect.x;
+		index->y[i] = rect.y;
+		index->h[i] = rect.h;
+		index->w[i] = rect.w;
+		index->object[i] = node->data;
+		index->type[i] = node->type;
+	}
+
+	return true;
+}
+
+static void getCells(eng_PickIndex *index, uint32_t item, uint32_t *firstColumn, uint32_t *lastColumn, uint32_t *firstRow, uint32_t *lastRow) {
+	*firstColumn = (uint32_t)((index->x[item] - index->left) / index->cellW);
+	*lastColumn = SDL_min((uint32_t)((index->x[item] + index->w[item] - index->left) / index->cellW), index->columns - 1);
+	*firstRow = (uint32_t)((index->y[item] - index->top) / index->cellH);
+	*lastRow = SDL_min((uint32_t)((index->y[item] + index->h[item] - index->top) / index->cellH), index->rows - 1);
+}
+
+static bool rebuild(eng_PickIndex *index) {
+	index->count = 0;
+	for (uint32_t i = 0; i < index->queueCount; i++) {
+		RenderQueue *queue = index->queues[i].queue != NULL ? index->queues[i].queue : eng_getRenderQueue();
+		if (!addItems(index, queue)) {
+			return false;
+		}
+	}
+
+	if (index->count == 0) {
+		index->columns = 0;
+		index->rows = 0;
+		return true;
+	}
+
+	float right = index->x[0] + index->w[0];
+	float bottom = index->y[0] + index->h[0];
+	index->left = index->x[0];
+	index->top = index->y[0];
+	for (uint32_t i = 1; i < index->count; i++) {
+		index->left = SDL_min(index->left, index->x[i]);
+		index->top = SDL_min(index->top, index->y[i]);
+		right = SDL_max(right, index->x[i] + index->w[i]);
+		bottom = SDL_max(bottom, index->y[i] + index->h[i]);
+	}
+
+	// Roughly one object per cell
+	uint32_t side = SDL_clamp((uint32_t)SDL_ceilf(SDL_sqrtf((float)index->count)), 1, ENG_PICK_MAX_CELLS);
+	index->columns = side;
+	index->rows = side;
+	index->cellW = (right - index->left) / side;
+	index->cellH = (bottom - index->top) / side;
+
+	uint32_t cellCount = index->columns * index->rows;
+	memset(index->cellStart, 0, (cellCount + 1) * sizeof(uint32_t));
+
+	uint32_t total = 0;
+	uint32_t firstColumn, lastColumn, firstRow, lastRow;
+	for (uint32_t i = 0; i < index->count; i++) {
+		getCells(index, i, &firstColumn, &lastColumn, &firstRow, &lastRow);
+		for (uint32_t row = firstRow; row <= lastRow; row++) {
+			for (uint32_t column = firstColumn; column <= lastColumn; column++) {
+				index->cellStart[row * index->columns + column]++;
+				total++;
+			}
+		}
+	}
+
+	if (total > index->cellItemCapacity) {
+		uint32_t capacity = SDL_max(total, index->cellItemCapacity * 2);
+		if (!growArray((void **)&index->cellItems, capacity, sizeof(uint32_t))) {
+			return false;
+		}
+		index->cellItemCapacity = capacity;
+	}
+
+	for (uint32_t i = 1; i < cellCount; i++) {
+		index->cellStart[i] += index->cellStart[i - 1];
+	}
+	index->cellStart[cellCount] = total;
+
+	// Filling each cell from its end puts the topmost object first
+	for (uint32_t i = 0; i < index->count; i++) {
+		getCells(index, i, &firstColumn, &lastColumn, &firstRow, &lastRow);
+		for (uint32_t row = firstRow; row <= lastRow; row++) {
+			for (uint32_t column = firstColumn; column <= lastColumn; column++) {
+				index->cellItems[--index->cellStart[row * index->columns + column]] = i;
+			}
+		}
+	}
+
+	index->rebuilds++;
+	eng_log(ENG_LOG_TRACE, ENG_LOG_INPUT, "Rebuilt pick index\tObjects: %u\tGrid: %ux%u", index->count, index->columns, index->rows);
+
+	return true;
+}
+
+// Versions only go up so the sum changes whenever any queue changes, it starts at 1 so a new or invalidated index always rebuilds
+static uint32_t getLayoutVersion(eng_PickIndex *index) {
+	uint32_t version = 1;
+	for (uint32_t i = 0; i < index->queueCount; i++) {
+		version += eng_getQueueVersion(index->queues[i].queue);
+	}
+
+	return version;
+}
+
+void *eng_pick(eng_PickIndex *index, float x, float y, Type *type) {
+	if (index == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	uint32_t version = getLayoutVersion(index);
+	if (index->version != version) {
+		if (!rebuild(index)) {
+			eng_setError(FAILED_TO_MALLOC);
+			index->count = 0;
+			index->columns = 0;
+			index->rows = 0;
+			return NULL;
+		}
+		index->version = version;
+	}
+
+	if (index->columns == 0 || x < index->left || y < index->top) {
+		return NULL;
+	}
+
+	uint32_t column = index->cellW > 0 ? (uint32_t)((x - index->left) / index->cellW) : 0;
+	uint32_t row = index->cellH > 0 ? (uint32_t)((y - index->top) / index->cellH) : 0;
+	if (column >= index->columns || row >= index->rows) {
+		return NULL;
+	}
+
+	uint32_t cell = row * index->columns + column;
+	for (uint32_t i = index->cellStart[cell]; i < index->cellStart[cell + 1]; i++) {
+		uint32_t item = index->cellItems[i];
+		if (x >= index->x[item] && x < index->x[item] + index->w[item] && y >= index->y[item] && y < index->y[item] + index->h[item]) {
+			if (type != NULL) {
+				*type = index->type[item];
+			}
+			return index->object[item];
+		}
+	}
+
+	return NULL;
+}
+
+void eng_invalidatePickIndex(eng_PickIndex *index) {
+	if (index != NULL) {
+		index->version = 0;
+	}
+}
+
+void eng_destroyPickIndex(eng_PickIndex *index) {
+	if (index == NULL) {
+		return;
+	}
+
+	free(index->queues);
+	free(index->x);
+	free(index->y);
+	free(index->h);
+	free(index->w);
+	free(index->object);
+	free(index->type);
+	free(index->cellStart);
+	free(index->cellItems);
+	free(index);
+}
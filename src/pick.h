@@ -0,0 +1,76 @@
+#ifndef PICK_H
+#define PICK_H
+
+#include "engine.h"
+
+/*
+* Finds the object under a point, for clicking on menus, inventories and level select grids.
+*
+* A pick index covers one or more render queues, each with a layer. The topmost object is the one on the highest layer and,
+* within a layer, the one drawn last. Rects, images and text can be picked, batches can't.
+*
+* The objects are sorted into a grid the first time the index is used and the grid is kept until the layout of one of its queues changes.
+* Every queue keeps its own layout version, adding, removing or reordering objects changes it and so do eng_updateTransforms, tweens and
+* physics when they actually move an object in the queue, so a menu isn't rebuilt because something moved in another queue. Objects moved
+* by setting x and y by hand aren't noticed, call eng_invalidatePickIndex after moving them.
+*/
+
+#define ENG_PICK_MAX_CELLS 128 // Most cells along each side of the grid
+
+typedef struct {
+	RenderQueue *queue;
+	int layer;
+} eng_PickQueue;
+
+typedef struct {
+	eng_PickQueue *queues;
+	uint32_t queueCount;
+	uint32_t queueCapacity;
+
+	// Every pickable object, a later object is above an earlier one
+	float *x;
+	float *y;
+	float *h;
+	float *w;
+	void **object;
+	Type *type;
+	uint32_t count;
+	uint32_t capacity;
+
+	// Grid over the objects, cellStart[i] to cellStart[i + 1] are the objects touching cell i from the top down
+	float left;
+	float top;
+	float cellW;
+	float cellH;
+	uint32_t columns;
+	uint32_t rows;
+	uint32_t *cellStart;
+	uint32_t *cellItems;
+	uint32_t cellItemCapacity;
+
+	uint32_t version;
+	uint32_t rebuilds;
+} eng_PickIndex;
+
+eng_PickIndex *eng_createPickIndex();
+
+/*
+* Adds a queue to the index, pass NULL for the main render queue. Queues on a higher layer are picked before queues on a lower one
+*/
+ENG_RESULT eng_addPickQueue(eng_PickIndex *index, RenderQueue *queue, int layer);
+
+ENG_RESULT eng_removePickQueue(eng_PickIndex *index, RenderQueue *queue);
+
+/*
+* Returns the topmost object under the point or NULL if there isn't one, type is set to the object's type if it isn't NULL
+*/
+void *eng_pick(eng_PickIndex *index, float x, float y, Type *type);
+
+/*
+* Rebuilds the grid on the next eng_pick
+*/
+void eng_invalidatePickIndex(eng_PickIndex *index);
+
+void eng_destroyPickIndex(eng_PickIndex *index);
+
+#endif
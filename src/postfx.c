@@ -0,0 +1,518 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "present.h"
+#include "postfx.h"
+
+typedef enum {
+	PASS_FADE,
+	PASS_WIPE,
+	PASS_TRANSITION,
+	PASS_PALETTE,
+	PASS_BLUR,
+} PASS_TYPE;
+
+typedef struct {
+	PASS_TYPE type;
+	float amount;
+	eng_Color color;
+	ENG_WIPE direction;
+	SDL_Texture *texture; // Transition tile
+	uint32_t levels;
+
+	// Palette colors in an open addressed table, used marks the slots that hold a color
+	uint32_t *keys;
+	uint32_t *values;
+	uint8_t *used;
+	uint32_t tableMask;
+} PostPass;
+
+static PostPass passes[ENG_MAX_POST_PASSES];
+static uint32_t passCount = 0;
+
+static SDL_Renderer *postRenderer = NULL;
+static SDL_Texture *frameTarget = NULL;
+static SDL_Texture *previousTarget = NULL;
+static SDL_Texture *blurTargets[ENG_MAX_BLUR_LEVELS];
+static SDL_Texture *paletteTexture = NULL;
+static bool drawingPost = false;
+
+// Timings of the passes that ran since the last eng_getPostPassTimes
+static eng_PassTime times[ENG_MAX_POST_PASSES];
+static uint32_t timeCount = 0;
+
+// Transition tiles are drawn with one geometry call
+static float *tileVertices = NULL;
+static float *tileUVs = NULL;
+static int *tileIndices = NULL;
+static uint32_t tileCapacity = 0;
+
+static const char *getPassName(PASS_TYPE type) {
+	switch (type) {
+		case PASS_FADE:
+			return "fade";
+		case PASS_WIPE:
+			return "wipe";
+		case PASS_TRANSITION:
+			return "transition";
+		case PASS_PALETTE:
+			return "palette";
+		case PASS_BLUR:
+			return "blur";
+		default:
+			return "pass";
+	}
+}
+
+static eng_PostPass addPass(PostPass pass) {
+	if (passCount == ENG_MAX_POST_PASSES) {
+		eng_setErrorDetail(INVALID_POST_PASS, "Only %d passes can be added", ENG_MAX_POST_PASSES);
+		return ENG_NO_POST_PASS;
+	}
+
+	passes[passCount] = pass;
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_RENDER, "Added %s pass\tPasses: %u", getPassName(pass.type), passCount + 1);
+
+	return passCount++;
+}
+
+eng_PostPass eng_addFadePass(eng_Color color) {
+	return addPass((PostPass) {
+		.type = PASS_FADE,
+		.color = color,
+	});
+}
+
+eng_PostPass eng_addWipePass(eng_Color color, ENG_WIPE direction) {
+	return addPass((PostPass) {
+		.type = PASS_WIPE,
+		.color = color,
+		.direction = direction,
+	});
+}
+
+eng_PostPass eng_addTransitionPass(Window *window, const char *path) {
+	if (window == NULL || path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_POST_PASS;
+	}
+
+	SDL_Texture *texture = eng_acquireTexture(window->pRenderer, path);
+	if (texture == NULL) {
+		return ENG_NO_POST_PASS;
+	}
+
+	eng_PostPass pass = addPass((PostPass) {
+		.type = PASS_TRANSITION,
+		.texture = texture,
+	});
+	if (pass == ENG_NO_POST_PASS) {
+		eng_releaseTexture(texture);
+	}
+
+	return pass;
+}
+
+static uint32_t hashColor(uint32_t color) {
+	color ^= color >> 16;
+	color *= 0x7FEB352D;
+	color ^= color >> 15;
+
+	return color;
+}
+
+eng_PostPass eng_addPalettePass(const uint32_t *from, const uint32_t *to, uint32_t count) {
+	if (from == NULL || to == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_POST_PASS;
+	}
+
+	// At most half full so lookups stay short
+	uint32_t size = 16;
+	while (size < count * 2) {
+		size *= 2;
+	}
+
+	PostPass pass = (PostPass) {
+		.type = PASS_PALETTE,
+		.keys = (uint32_t *)malloc(size * sizeof(uint32_t)),
+		.values = (uint32_t *)malloc(size * sizeof(uint32_t)),
+		.used = (uint8_t *)calloc(size, sizeof(uint8_t)),
+		.tableMask = size - 1,
+	};
+	if (pass.keys == NULL || pass.values == NULL || pass.used == NULL) {
+		free(pass.keys);
+		free(pass.values);
+		free(pass.used);
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_NO_POST_PASS;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t slot = hashColor(from[i]) & pass.tableMask;
+		while (pass.used[slot] && pass.keys[slot] != from[i]) {
+			slot = (slot + 1) & pass.tableMask;
+		}
+		pass.keys[slot] = from[i];
+		pass.values[slot] = to[i];
+		pass.used[slot] = 1;
+	}
+
+	eng_PostPass index = addPass(pass);
+	if (index == ENG_NO_POST_PASS) {
+		free(pass.keys);
+		free(pass.values);
+		free(pass.used);
+	}
+
+	return index;
+}
+
+eng_PostPass eng_addBlurPass(uint32_t levels) {
+	return addPass((PostPass) {
+		.type = PASS_BLUR,
+		.levels = SDL_clamp(levels, 1, ENG_MAX_BLUR_LEVELS),
+	});
+}
+
+float *eng_getPostPassAmount(eng_PostPass pass) {
+	if (pass >= passCount) {
+		eng_setError(INVALID_POST_PASS);
+		return NULL;
+	}
+
+	return &passes[pass].amount;
+}
+
+static void destroyTargets() {
+	if (drawingPost) {
+		SDL_SetRenderTarget(postRenderer, previousTarget);
+		drawingPost = false;
+	}
+	eng_destroyTexture(frameTarget);
+	frameTarget = NULL;
+	for (uint32_t i = 0; i < ENG_MAX_BLUR_LEVELS; i++) {
+		eng_destroyTexture(blurTargets[i]);
+		blurTargets[i] = NULL;
+	}
+	eng_destroyTexture(paletteTexture);
+	paletteTexture = NULL;
+	postRenderer = NULL;
+}
+
+void eng_clearPostPasses() {
+	for (uint32_t i = 0; i < passCount; i++) {
+		eng_releaseTexture(passes[i].texture);
+		free(passes[i].keys);
+		free(passes[i].values);
+		free(passes[i].used);
+	}
+	passCount = 0;
+	timeCount = 0;
+
+	destroyTargets();
+	free(tileVertices);
+	free(tileUVs);
+	free(tileIndices);
+	tileVertices = NULL;
+	tileUVs = NULL;
+	tileIndices = NULL;
+	tileCapacity = 0;
+}
+
+static bool hasActivePass() {
+	for (uint32_t i = 0; i < passCount; i++) {
+		if (passes[i].amount > 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Creates a render target of the size unless it already has it
+static SDL_Texture *prepareTarget(SDL_Texture *target, SDL_TextureAccess access, int width, int height) {
+	if (target != NULL && target->w == width && target->h == height) {
+		return target;
+	}
+
+	eng_destroyTexture(target);
+	target = SDL_CreateTexture(postRenderer, access == SDL_TEXTUREACCESS_STREAMING ? SDL_PIXELFORMAT_RGBA8888 : SDL_PIXELFORMAT_RGBA32,
+		access, width, height);
+	if (target == NULL) {
+		eng_setErrorDetail(FAILED_TO_SET_PRESENTATION, "Failed to create a %dx%d post-process target", width, height);
+		return NULL;
+	}
+	eng_addTextureMemory(target);
+
+	return target;
+}
+
+void eng_beginPostProcess(Window *window) {
+	if (!hasActivePass() || window->pRenderer == NULL || window->width <= 0 || window->height <= 0) {
+		return;
+	}
+
+	if (postRenderer != window->pRenderer) {
+		destroyTargets();
+		postRenderer = window->pRenderer;
+	}
+
+	frameTarget = prepareTarget(frameTarget, SDL_TEXTUREACCESS_TARGET, window->width, window->height);
+	if (frameTarget == NULL) {
+		return;
+	}
+
+	previousTarget = SDL_GetRenderTarget(postRenderer);
+	SDL_SetRenderTarget(postRenderer, frameTarget);
+	drawingPost = true;
+}
+
+static void renderFade(PostPass *pass) {
+	SDL_SetRenderDrawBlendMode(postRenderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(postRenderer, pass->color.r, pass->color.g, pass->color.b, (Uint8)(pass->color.a * SDL_min(pass->amount, 1.0f)));
+	SDL_RenderFillRect(postRenderer, NULL);
+	eng_countDrawCalls(1, 0);
+}
+
+static void renderWipe(PostPass *pass) {
+	float width = frameTarget->w;
+	float height = frameTarget->h;
+	float amount = SDL_min(pass->amount, 1.0f);
+
+	SDL_FRect rect = (SDL_FRect) {
+		.h = height,
+		.w = width * amount,
+		.x = 0,
+		.y = 0,
+	};
+	if (pass->direction == ENG_WIPE_RIGHT) {
+		rect.x = width - rect.w;
+	} else if (pass->direction == ENG_WIPE_UP || pass->direction == ENG_WIPE_DOWN) {
+		rect.w = width;
+		rect.h = height * amount;
+		rect.y = pass->direction == ENG_WIPE_UP ? height - rect.h : 0;
+	}
+
+	SDL_SetRenderDrawBlendMode(postRenderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(postRenderer, pass->color.r, pass->color.g, pass->color.b, pass->color.a);
+	SDL_RenderFillRect(postRenderer, &rect);
+	eng_countDrawCalls(1, 0);
+}
+
+static void renderTransition(PostPass *pass) {
+	float tile = pass->texture->w;
+	uint32_t columns = (uint32_t)(frameTarget->w / tile) + 2;
+	uint32_t rows = (uint32_t)(frameTarget->h / tile) + 2;
+	uint32_t count = columns * rows;
+
+	if (count > tileCapacity) {
+		float *newVertices = realloc(tileVertices, count * 8 * sizeof(float));
+		if (newVertices != NULL) {
+			tileVertices = newVertices;
+		}
+		float *newUVs = realloc(tileUVs, count * 8 * sizeof(float));
+		if (newUVs != NULL) {
+			tileUVs = newUVs;
+		}
+		int *newIndices = realloc(tileIndices, count * 6 * sizeof(int));
+		if (newIndices != NULL) {
+			tileIndices = newIndices;
+		}
+		if (newVertices == NULL || newUVs == NULL || newIndices == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			return;
+		}
+
+		eng_fillQuadIndices(tileIndices, tileCapacity, count);
+		for (uint32_t i = tileCapacity; i < count; i++) {
+			float *uv = &tileUVs[i * 8];
+			uv[0] = 0; uv[1] = 0;
+			uv[2] = 1; uv[3] = 0;
+			uv[4] = 1; uv[5] = 1;
+			uv[6] = 0; uv[7] = 1;
+		}
+		tileCapacity = count;
+	}
+
+	// A tile twice the spacing covers the gaps between its neighbours, so at 1 the frame is covered
+	float half = tile * SDL_min(pass->amount, 1.0f);
+	for (uint32_t row = 0; row < rows; row++) {
+		for (uint32_t column = 0; column < columns; column++) {
+			float *vertex = &tileVertices[(row * columns + column) * 8];
+			float left = column * tile - half;
+			float top = row * tile - half;
+			float right = column * tile + half;
+			float bottom = row * tile + half;
+			vertex[0] = left; vertex[1] = top;
+			vertex[2] = right; vertex[3] = top;
+			vertex[4] = right; vertex[5] = bottom;
+			vertex[6] = left; vertex[7] = bottom;
+		}
+	}
+
+	SDL_FColor white = (SDL_FColor) { 1.0f, 1.0f, 1.0f, 1.0f };
+	SDL_SetTextureBlendMode(pass->texture, SDL_BLENDMODE_BLEND);
+	SDL_RenderGeometryRaw(postRenderer, pass->texture, tileVertices, 2 * sizeof(float), &white, 0, tileUVs, 2 * sizeof(float), count * 4,
+		tileIndices, count * 6, sizeof(int));
+	eng_countDrawCalls(1, 1);
+}
+
+static void renderPalette(PostPass *pass) {
+	SDL_Surface *read = SDL_RenderReadPixels(postRenderer, NULL);
+	if (read == NULL) {
+		return;
+	}
+
+	// RGBA8888 keeps pixels in the same order eng_packColor does
+	SDL_Surface *frame = SDL_ConvertSurface(read, SDL_PIXELFORMAT_RGBA8888);
+	SDL_DestroySurface(read);
+	paletteTexture = frame != NULL ? prepareTarget(paletteTexture, SDL_TEXTUREACCESS_STREAMING, frame->w, frame->h) : NULL;
+	if (paletteTexture == NULL) {
+		SDL_DestroySurface(frame);
+		return;
+	}
+
+	// Neighbouring pixels are usually the same color so the last lookup is kept
+	uint32_t lastColor = 0;
+	uint32_t lastResult = 0;
+	bool hasLast = false;
+	for (int y = 0; y < frame->h; y++) {
+		uint32_t *row = (uint32_t *)((uint8_t *)frame->pixels + y * frame->pitch);
+		for (int x = 0; x < frame->w; x++) {
+			uint32_t color = row[x];
+			if (!hasLast || color != lastColor) {
+				lastColor = color;
+				lastResult = color;
+				hasLast = true;
+
+				uint32_t slot = hashColor(color) & pass->tableMask;
+				while (pass->used[slot]) {
+					if (pass->keys[slot] == color) {
+						lastResult = pass->values[slot];
+						break;
+					}
+					slot = (slot + 1) & pass->tableMask;
+				}
+			}
+			row[x] = lastResult;
+		}
+	}
+
+	SDL_UpdateTexture(paletteTexture, NULL, frame->pixels, frame->pitch);
+	SDL_DestroySurface(frame);
+
+	SDL_SetTextureBlendMode(paletteTexture, pass->amount >= 1.0f ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+	SDL_SetTextureAlphaMod(paletteTexture, (Uint8)(255 * SDL_min(pass->amount, 1.0f)));
+	SDL_RenderTexture(postRenderer, paletteTexture, NULL, NULL);
+	eng_countDrawCalls(1, 0);
+}
+
+static void renderBlur(PostPass *pass) {
+	SDL_Texture *source = frameTarget;
+	uint32_t levels = 0;
+
+	// Each level is half the size of the one before, linear filtering averages four pixels into one
+	SDL_SetTextureScaleMode(frameTarget, SDL_SCALEMODE_LINEAR);
+	SDL_SetTextureBlendMode(frameTarget, SDL_BLENDMODE_NONE);
+	for (uint32_t i = 0; i < pass->levels; i++) {
+		int width = frameTarget->w >> (i + 1);
+		int height = frameTarget->h >> (i + 1);
+		if (width < 1 || height < 1) {
+			break;
+		}
+
+		blurTargets[i] = prepareTarget(blurTargets[i], SDL_TEXTUREACCESS_TARGET, width, height);
+		if (blurTargets[i] == NULL) {
+			break;
+		}
+		SDL_SetTextureScaleMode(blurTargets[i], SDL_SCALEMODE_LINEAR);
+		SDL_SetTextureBlendMode(blurTargets[i], SDL_BLENDMODE_NONE);
+
+		SDL_SetRenderTarget(postRenderer, blurTargets[i]);
+		SDL_RenderTexture(postRenderer, source, NULL, NULL);
+		source = blurTargets[i];
+		levels++;
+	}
+
+	// Scaling back up one level at a time smooths out the blocks a single big stretch would leave
+	for (uint32_t i = levels; i > 1; i--) {
+		SDL_SetRenderTarget(postRenderer, blurTargets[i - 2]);
+		SDL_RenderTexture(postRenderer, blurTargets[i - 1], NULL, NULL);
+	}
+
+	SDL_SetRenderTarget(postRenderer, frameTarget);
+	if (levels > 0) {
+		SDL_SetTextureBlendMode(blurTargets[0], SDL_BLENDMODE_BLEND);
+		SDL_SetTextureAlphaMod(blurTargets[0], (Uint8)(255 * SDL_min(pass->amount, 1.0f)));
+		SDL_RenderTexture(postRenderer, blurTargets[0], NULL, NULL);
+		SDL_SetTextureAlphaMod(blurTargets[0], 255);
+	}
+	eng_countDrawCalls(levels * 2, 0);
+}
+
+void eng_endPostProcess(Window *window) {
+	timeCount = 0;
+	if (!drawingPost) {
+		return;
+	}
+	drawingPost = false;
+
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(postRenderer, &previousBlendMode);
+
+	for (uint32_t i = 0; i < passCount; i++) {
+		PostPass *pass = &passes[i];
+		if (pass->amount <= 0) {
+			continue;
+		}
+
+		uint64_t start = SDL_GetTicksNS();
+		switch (pass->type) {
+			case PASS_FADE:
+				renderFade(pass);
+				break;
+			case PASS_WIPE:
+				renderWipe(pass);
+				break;
+			case PASS_TRANSITION:
+				renderTransition(pass);
+				break;
+			case PASS_PALETTE:
+				renderPalette(pass);
+				break;
+			case PASS_BLUR:
+				renderBlur(pass);
+				break;
+		}
+
+		// Renderers queue draws, flushing makes the time land on the pass that caused it
+		SDL_FlushRenderer(postRenderer);
+		times[timeCount++] = (eng_PassTime) {
+			.name = getPassName(pass->type),
+			.ms = (float)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS,
+		};
+	}
+
+	SDL_SetRenderDrawBlendMode(postRenderer, previousBlendMode);
+	SDL_SetRenderTarget(postRenderer, previousTarget);
+
+	SDL_SetTextureBlendMode(frameTarget, SDL_BLENDMODE_NONE);
+	SDL_SetTextureScaleMode(frameTarget, eng_isPixelArt() ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+	SDL_RenderTexture(postRenderer, frameTarget, NULL, NULL);
+	eng_countDrawCalls(1, 0);
+}
+
+uint32_t eng_getPostPassTimes(eng_PassTime *out, uint32_t max) {
+	uint32_t count = SDL_min(timeCount, max);
+	memcpy(out, times, count * sizeof(eng_PassTime));
+	timeCount = 0;
+
+	return count;
+}
@@ -0,0 +1,72 @@
+#ifndef POSTFX_H
+#define POSTFX_H
+
+#include "engine.h"
+
+/*
+* Post-processing passes over the finished frame, built from render targets and plain draws so they run on every renderer including the software one.
+*
+* While any pass has an amount above 0 the render queue is drawn into an offscreen target, the passes run over it in the order they were
+* added and the result is drawn to the window before the HUD. With every amount at 0 nothing changes and there's no extra cost.
+* Every pass is timed on its own and shows up in eng_getStats and on the HUD.
+*
+* The amount of a pass goes from 0 (off) to 1 (full), eng_getPostPassAmount returns a pointer to it so it can be animated with eng_tween.
+* Fades, wipes and transitions draw over the frame. Blur halves the frame levels times and scales it back up, blending the result in by
+* the amount. Palette swaps read the frame back to change colors on the CPU, which is cheap with the software renderer but stalls a GPU,
+* keep it to low virtual resolutions there.
+*/
+
+#define ENG_MAX_POST_PASSES 8
+#define ENG_MAX_BLUR_LEVELS 6
+#define ENG_NO_POST_PASS UINT32_MAX
+
+typedef uint32_t eng_PostPass;
+
+typedef enum {
+	ENG_WIPE_LEFT, // Covers the frame starting from the left edge
+	ENG_WIPE_RIGHT,
+	ENG_WIPE_UP, // Covers the frame starting from the bottom edge
+	ENG_WIPE_DOWN,
+} ENG_WIPE;
+
+typedef struct {
+	const char *name;
+	float ms;
+} eng_PassTime;
+
+/*
+* Blends color over the frame, at an amount of 1 the frame is covered by color at its own alpha
+*/
+eng_PostPass eng_addFadePass(eng_Color color);
+
+/*
+* Covers the amount of the frame from one side with color
+*/
+eng_PostPass eng_addWipePass(eng_Color color, ENG_WIPE direction);
+
+/*
+* Tiles the image at path over the frame growing each tile from nothing at 0 to covering its neighbours at 1, made for images/Other/Transition.png
+*/
+eng_PostPass eng_addTransitionPass(Window *window, const char *path);
+
+/*
+* Replaces every pixel that is exactly one of from with the matching color in to, colors are packed with eng_packColor
+*/
+eng_PostPass eng_addPalettePass(const uint32_t *from, const uint32_t *to, uint32_t count);
+
+/*
+* Blurs the frame by downscaling it levels times, levels is clamped between 1 and ENG_MAX_BLUR_LEVELS
+*/
+eng_PostPass eng_addBlurPass(uint32_t levels);
+
+/*
+* Returns the amount of a pass for setting or tweening, NULL if the pass doesn't exist
+*/
+float *eng_getPostPassAmount(eng_PostPass pass);
+
+/*
+* Removes every pass and frees the offscreen targets
+*/
+void eng_clearPostPasses();
+
+#endif
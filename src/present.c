@@ -0,0 +1,245 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "present.h"
+
+#define MIN_RENDER_SCALE 0.25f
+
+static ENG_SCALE_MODE scaleMode = ENG_SCALE_DISABLED;
+static SDL_Renderer *presentRenderer = NULL;
+static int virtualWidth = 0;
+static int virtualHeight = 0;
+
+static float renderScale = 1.0f;
+static SDL_Texture *scaledTarget = NULL;
+static SDL_Texture *previousTarget = NULL;
+static bool drawingScaled = false;
+
+static bool pixelArt = false;
+
+static float targetMS = 0;
+static float minScale = 0.5f;
+static float averageMS = 0;
+static uint32_t framesSinceChange = 0;
+static uint64_t lastFrameNS = 0;
+
+static SDL_RendererLogicalPresentation getPresentation(ENG_SCALE_MODE mode) {
+	switch (mode) {
+		case ENG_SCALE_STRETCH:
+			return SDL_LOGICAL_PRESENTATION_STRETCH;
+		case ENG_SCALE_LETTERBOX:
+			return SDL_LOGICAL_PRESENTATION_LETTERBOX;
+		case ENG_SCALE_OVERSCAN:
+			return SDL_LOGICAL_PRESENTATION_OVERSCAN;
+		case ENG_SCALE_INTEGER:
+			return SDL_LOGICAL_PRESENTATION_INTEGER_SCALE;
+		default:
+			return SDL_LOGICAL_PRESENTATION_DISABLED;
+	}
+}
+
+static void destroyScaledTarget() {
+	eng_destroyTexture(scaledTarget);
+	scaledTarget = NULL;
+}
+
+// Only the window whose renderer got the virtual resolution has one, other windows keep their real size and mouse coordinates
+bool eng_hasVirtualResolution(Window *window) {
+	return scaleMode != ENG_SCALE_DISABLED && presentRenderer != NULL && window->pRenderer == presentRenderer;
+}
+
+void eng_updateWindowSize(Window *window) {
+	if (eng_hasVirtualResolution(window)) {
+		window->width = virtualWidth;
+		window->height = virtualHeight;
+	} else if (window->pWindow != NULL) {
+		SDL_GetWindowSize(window->pWindow, &window->width, &window->height);
+	} else if (window->pSurface != NULL) {
+		window->width = window->pSurface->w;
+		window->height = window->pSurface->h;
+	}
+}
+
+ENG_RESULT eng_setVirtualResolution(Window *window, uint32_t width, uint32_t height, ENG_SCALE_MODE mode) {
+	if (window == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (mode != ENG_SCALE_DISABLED && (width == 0 || height == 0)) {
+		return eng_setErrorDetail(FAILED_TO_SET_PRESENTATION, "%ux%u", width, height);
+	}
+
+	if (mode == ENG_SCALE_DISABLED) {
+		width = 0;
+		height = 0;
+	}
+
+	if (!SDL_SetRenderLogicalPresentation(window->pRenderer, width, height, getPresentation(mode))) {
+		return eng_setErrorDetail(FAILED_TO_SET_PRESENTATION, "%ux%u", width, height);
+	}
+
+	scaleMode = mode;
+	presentRenderer = window->pRenderer;
+	virtualWidth = width;
+	virtualHeight = height;
+	eng_updateWindowSize(window);
+	destroyScaledTarget();
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_RENDER, "Virtual resolution %dx%d\tMode: %d", window->width, window->height, mode);
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_setRenderScale(Window *window, float scale) {
+	if (window == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	renderScale = SDL_clamp(scale, MIN_RENDER_SCALE, 1.0f);
+	targetMS = 0;
+
+	return SUCCESS;
+}
+
+float eng_getRenderScale() {
+	return renderScale;
+}
+
+ENG_RESULT eng_setDynamicRenderScale(Window *window, float frameMS, float lowestScale) {
+	if (window == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	targetMS = SDL_max(frameMS, 0.0f);
+	minScale = SDL_clamp(lowestScale, MIN_RENDER_SCALE, 1.0f);
+	averageMS = 0;
+	framesSinceChange = 0;
+	lastFrameNS = 0;
+
+	return SUCCESS;
+}
+
+void eng_beginScaledFrame(Window *window) {
+	if (renderScale >= 1.0f || window->width <= 0 || window->height <= 0) {
+		return;
+	}
+
+	// The texture stays at full size and only the top left part is drawn to, so changing the scale never reallocates
+	if (scaledTarget == NULL || scaledTarget->w != window->width || scaledTarget->h != window->height) {
+		destroyScaledTarget();
+		scaledTarget = SDL_CreateTexture(window->pRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, window->width, window->height);
+		if (scaledTarget == NULL) {
+			eng_setErrorDetail(FAILED_TO_SET_PRESENTATION, "Failed to create a %dx%d render target", window->width, window->height);
+			renderScale = 1.0f;
+			return;
+		}
+		eng_addTextureMemory(scaledTarget);
+		SDL_SetTextureScaleMode(scaledTarget, scaleMode == ENG_SCALE_INTEGER || pixelArt ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+	}
+
+	// Post-processing may have set its own target, the scaled frame is drawn into that one
+	previousTarget = SDL_GetRenderTarget(window->pRenderer);
+	SDL_SetRenderTarget(window->pRenderer, scaledTarget);
+	SDL_SetRenderScale(window->pRenderer, renderScale, renderScale);
+	drawingScaled = true;
+}
+
+void eng_endScaledFrame(Window *window) {
+	if (!drawingScaled) {
+		return;
+	}
+	drawingScaled = false;
+
+	SDL_SetRenderScale(window->pRenderer, 1.0f, 1.0f);
+	SDL_SetRenderTarget(window->pRenderer, previousTarget);
+
+	SDL_SetRenderDrawColor(window->pRenderer, 0, 0, 0, 255);
+	SDL_RenderClear(window->pRenderer);
+
+	SDL_FRect source = (SDL_FRect) {
+		.h = window->height * renderScale,
+		.w = window->width * renderScale,
+		.x = 0,
+		.y = 0,
+	};
+	SDL_RenderTexture(window->pRenderer, scaledTarget, &source, NULL);
+	eng_countDrawCalls(1, 0);
+}
+
+void eng_updateRenderScale(uint64_t sleptNS) {
+	uint64_t now = SDL_GetTicksNS();
+	if (targetMS <= 0 || lastFrameNS == 0) {
+		lastFrameNS = now;
+		return;
+	}
+
+	uint64_t frameNS = now - lastFrameNS;
+	float busyMS = (float)(frameNS > sleptNS ? frameNS - sleptNS : 0) / SDL_NS_PER_MS;
+	lastFrameNS = now;
+
+	averageMS = averageMS == 0 ? busyMS : averageMS * 0.9f + busyMS * 0.1f;
+	if (++framesSinceChange < ENG_RENDER_SCALE_FRAMES) {
+		return;
+	}
+
+	// Only raise the scale with plenty of headroom so it doesn't bounce between two steps
+	float previousScale = renderScale;
+	if (averageMS > targetMS && renderScale > minScale) {
+		renderScale = SDL_max(renderScale - ENG_RENDER_SCALE_STEP, minScale);
+	} else if (averageMS < targetMS * 0.8f && renderScale < 1.0f) {
+		renderScale = SDL_min(renderScale + ENG_RENDER_SCALE_STEP, 1.0f);
+	}
+	framesSinceChange = 0;
+
+	if (renderScale != previousScale) {
+		eng_log(ENG_LOG_DEBUG, ENG_LOG_RENDER, "Render scale %.2f\tFrame: %.2f ms\tTarget: %.2f ms", renderScale, averageMS, targetMS);
+	}
+}
+
+void eng_setPixelArt(bool enabled) {
+	pixelArt = enabled;
+	destroyScaledTarget();
+}
+
+bool eng_isPixelArt() {
+	return pixelArt;
+}
+
+void eng_applyTextureFilter(SDL_Texture *texture) {
+	if (pixelArt) {
+		SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+	}
+}
+
+ENG_RESULT eng_setImageFilter(eng_Texture *image, ENG_FILTER filter) {
+	if (image == NULL || image->texture == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (!SDL_SetTextureScaleMode(image->texture, filter == ENG_FILTER_NEAREST ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR)) {
+		return eng_setErrorDetail(FAILED_TO_SET_PRESENTATION, "Failed to set the texture filter");
+	}
+
+	return SUCCESS;
+}
+
+void eng_windowToVirtual(Window *window, float *x, float *y) {
+	if (window == NULL || !eng_hasVirtualResolution(window)) {
+		return;
+	}
+
+	SDL_RenderCoordinatesFromWindow(presentRenderer, *x, *y, x, y);
+}
+
+void eng_destroyPresent() {
+	destroyScaledTarget();
+	scaleMode = ENG_SCALE_DISABLED;
+	presentRenderer = NULL;
+	renderScale = 1.0f;
+	targetMS = 0;
+}
@@ -0,0 +1,65 @@
+#ifndef PRESENT_H
+#define PRESENT_H
+
+#include "engine.h"
+
+/*
+* Virtual resolution and render scaling.
+*
+* With a virtual resolution the game always draws in the same coordinates and SDL scales the result to the window, Window.width and height
+* report the virtual size so layout code like eng_centerText keeps working. Mouse positions are converted to virtual coordinates.
+* Only the window passed to eng_setVirtualResolution is scaled, other applications keep their real size and mouse coordinates.
+*
+* The render scale draws the game into a smaller texture that is stretched to the virtual resolution, trading sharpness for frame rate.
+* With a target frame time set the scale is lowered when frames take too long and raised again when there is time to spare.
+*/
+
+typedef enum {
+	ENG_SCALE_DISABLED,
+	ENG_SCALE_STRETCH,
+	ENG_SCALE_LETTERBOX,
+	ENG_SCALE_OVERSCAN,
+	ENG_SCALE_INTEGER,
+} ENG_SCALE_MODE;
+
+#define ENG_RENDER_SCALE_STEP 0.05f
+#define ENG_RENDER_SCALE_FRAMES 30
+
+/*
+* Draws in width by height coordinates no matter how big the window is, ENG_SCALE_INTEGER only scales by whole numbers for pixel art.
+* Pass ENG_SCALE_DISABLED to go back to drawing in window coordinates
+*/
+ENG_RESULT eng_setVirtualResolution(Window *window, uint32_t width, uint32_t height, ENG_SCALE_MODE mode);
+
+/*
+* Draws at scale times the virtual resolution, scale is clamped between 0.25 and 1. Turns off the dynamic scale
+*/
+ENG_RESULT eng_setRenderScale(Window *window, float scale);
+
+float eng_getRenderScale();
+
+/*
+* Adjusts the render scale every ENG_RENDER_SCALE_FRAMES frames to keep the time spent on a frame under targetMS, never going below minScale.
+* Time spent sleeping in eng_pollEvent for the fps limit isn't counted. Pass 0 to turn it off
+*/
+ENG_RESULT eng_setDynamicRenderScale(Window *window, float targetMS, float minScale);
+
+typedef enum {
+	ENG_FILTER_LINEAR,
+	ENG_FILTER_NEAREST,
+} ENG_FILTER;
+
+/*
+* Pixel art mode draws rects, images and text at whole pixel positions and loads every texture with nearest sampling so scaled sprites stay sharp.
+* Textures loaded before it's turned on keep their filter, use eng_setImageFilter to change them
+*/
+void eng_setPixelArt(bool enabled);
+
+bool eng_isPixelArt();
+
+/*
+* Sets how one image is sampled when it's drawn bigger or smaller than the file, images made from the same file share a texture so they all change
+*/
+ENG_RESULT eng_setImageFilter(eng_Texture *image, ENG_FILTER filter);
+
+#endif
@@ -0,0 +1,252 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "batch.h"
+#include "scene.h"
+#include "capture.h"
+
+/*
+* Render regression tests, every case draws a fixed scene with a headless application and compares the frame with its golden image:
+*   render_tests [--record] [case...]
+* Run it from the repository root so the images, fonts and golden images are found. Without cases every recorded case runs, the same ones
+* ctest runs. --record saves the frames as the golden images instead of comparing them, without cases it records every case.
+* Look at the new images before checking them in, then mark the case recorded here and in RENDER_CASES_RECORDED in CMakeLists.txt.
+*/
+
+#define FRAME_WIDTH 96
+#define FRAME_HEIGHT 64
+#define GOLDEN_DIRECTORY "tests/golden"
+
+// Blending rounds differently between SDL's blitters, everything else has to match exactly
+#define TOLERANCE 2
+
+typedef bool (*BuildCase)(Application *app);
+
+typedef struct {
+	const char *name;
+	BuildCase build;
+	// Whether tests/golden has the case's image, only recorded cases run by default
+	bool recorded;
+} RenderCase;
+
+static const eng_Color background = {24, 24, 40, 255};
+
+static bool queueRect(uint32_t h, uint32_t w, uint32_t x, uint32_t y, eng_Color color) {
+	eng_Rect *rect = eng_createRect(h, w, x, y, color);
+	return rect != NULL && eng_addObjectToRenderQueue(rect, TYPE_RECT) == SUCCESS;
+}
+
+static bool buildRects(Application *app) {
+	if (!queueRect(24, 40, 4, 4, (eng_Color){220, 60, 50, 255})
+		|| !queueRect(30, 36, 28, 16, (eng_Color){40, 120, 230, 128})
+		|| !queueRect(20, 30, 80, 50, (eng_Color){250, 210, 60, 255})) {
+		return false;
+	}
+
+	eng_Texture *image = eng_createImage(app->window, "images/Menu/Buttons/Play.png", 22, 21, 60, 6);
+	return image != NULL && eng_addObjectToRenderQueue(image, TYPE_TEXTURE) == SUCCESS;
+}
+
+static bool buildRectBatch(Application *app) {
+	eng_RectBatch *batch = eng_createRectBatch(4);
+	if (batch == NULL) {
+		return false;
+	}
+
+	if (eng_rectBatchAdd(batch, 16, 16, 4, 4, eng_packColor((eng_Color){255, 0, 0, 255})) == ENG_BATCH_INVALID
+		|| eng_rectBatchAdd(batch, 16, 16, 12, 12, eng_packColor((eng_Color){0, 255, 0, 160})) == ENG_BATCH_INVALID
+		|| eng_rectBatchAdd(batch, 40, 20, 40, 8, eng_packColor((eng_Color){255, 255, 255, 64})) == ENG_BATCH_INVALID
+		|| eng_rectBatchAdd(batch, 10, 90, 2, 50, eng_packColor((eng_Color){30, 200, 200, 255})) == ENG_BATCH_INVALID) {
+		eng_destroyRectBatch(batch);
+		return false;
+	}
+
+	if (eng_addObjectToRenderQueue(batch, TYPE_RECT_BATCH) != SUCCESS) {
+		eng_destroyRectBatch(batch);
+		return false;
+	}
+
+	return true;
+}
+
+// The sheet is 64 by 32 so the batch's texture coordinates are exact and every sprite lands on whole pixels
+static bool buildSpriteBatch(Application *app) {
+	eng_SpriteBatch *batch = eng_createSpriteBatch(app->window, "images/Traps/Fire/Hit (16x32).png", 16, 32, 1, 8);
+	if (batch == NULL) {
+		return false;
+	}
+
+	if (eng_spriteBatchAdd(batch, 4, 4, 0, 0) == ENG_BATCH_INVALID
+		|| eng_spriteBatchAdd(batch, 24, 4, 1, 0) == ENG_BATCH_INVALID
+		|| eng_spriteBatchAdd(batch, 44, 4, 2, 0) == ENG_BATCH_INVALID
+		|| eng_spriteBatchAdd(batch, 64, 4, 3, 0) == ENG_BATCH_INVALID
+		|| eng_spriteBatchAdd(batch, 30, 28, 1, 0) == ENG_BATCH_INVALID) {
+		eng_destroySpriteBatch(batch);
+		return false;
+	}
+
+	if (eng_addObjectToRenderQueue(batch, TYPE_SPRITE_BATCH) != SUCCESS) {
+		eng_destroySpriteBatch(batch);
+		return false;
+	}
+
+	return true;
+}
+
+static bool buildText(Application *app) {
+	eng_Text *text = eng_createText(app->window, "fonts/arial.ttf", 20, "Golden", (eng_Color){240, 240, 240, 255}, 6, 20);
+	return text != NULL && eng_addObjectToRenderQueue(text, TYPE_TEXT) == SUCCESS;
+}
+
+// Goes through a scene file on disk so the writer, the loader and the scene renderer are all covered
+static bool buildScene(Application *app) {
+	const char *directory = SDL_GetBasePath();
+	char path[1024];
+	snprintf(path, sizeof(path), "%srender_tests.scene", directory != NULL ? directory : "");
+
+	eng_SceneWriter *writer = eng_createSceneWriter();
+	if (writer == NULL) {
+		return false;
+	}
+
+	uint32_t box = eng_sceneAddImageAsset(writer, "images/Items/Boxes/Box1/Idle.png");
+	uint32_t fire = eng_sceneAddImageAsset(writer, "images/Traps/Fire/Hit (16x32).png");
+	ENG_RESULT result = eng_sceneAddRect(writer, 12, 96, 0, 52, (eng_Color){90, 60, 40, 255});
+	if (result == SUCCESS) {
+		result = eng_sceneAddRect(writer, 40, 30, 60, 4, (eng_Color){255, 100, 180, 100});
+	}
+	if (result == SUCCESS) {
+		result = eng_sceneAddImage(writer, box, 24, 28, 6, 20, 0, 0, 0, 0);
+	}
+	if (result == SUCCESS) {
+		result = eng_sceneAddImage(writer, fire, 32, 16, 40, 16, 32, 0, 16, 32);
+	}
+	if (result == SUCCESS) {
+		result = eng_writeScene(writer, path);
+	}
+	eng_destroySceneWriter(writer);
+	if (result != SUCCESS) {
+		return false;
+	}
+
+	eng_Scene *scene = eng_loadScene(app->window, path);
+	SDL_RemovePath(path);
+	if (scene == NULL) {
+		return false;
+	}
+
+	if (eng_addObjectToRenderQueue(scene, TYPE_SCENE) != SUCCESS) {
+		eng_destroyScene(scene);
+		return false;
+	}
+
+	return true;
+}
+
+// The golden images have to come from a real SDL3 build on the reference machine, glyphs also depend on the FreeType and SDL_ttf builds
+static const RenderCase cases[] = {
+	{"rects", buildRects, false},
+	{"rect_batch", buildRectBatch, false},
+	{"sprite_batch", buildSpriteBatch, false},
+	{"text", buildText, false},
+	{"scene", buildScene, false},
+};
+
+static bool runCase(const RenderCase *renderCase, bool record) {
+	Application *app = eng_createHeadlessApplication(FRAME_WIDTH, FRAME_HEIGHT);
+	if (app == NULL) {
+		printf("FAIL %s\t%s\n", renderCase->name, eng_getError());
+		return false;
+	}
+
+	bool passed = false;
+	if (!renderCase->build(app)) {
+		printf("FAIL %s\tBuilding the scene: %s %s\n", renderCase->name, eng_getError(), eng_getErrorDetail());
+	} else {
+		char goldenPath[256];
+		snprintf(goldenPath, sizeof(goldenPath), "%s/%s.png", GOLDEN_DIRECTORY, renderCase->name);
+
+		eng_FrameCheck check;
+		if (eng_checkFrame(app, background, goldenPath, TOLERANCE, record, &check) != SUCCESS) {
+			printf("FAIL %s\t%s %s\n", renderCase->name, eng_getError(), eng_getErrorDetail());
+		} else {
+			passed = check.diff.passed;
+			printf("%s %s\tMismatched: %u of %u\tMax difference: %u\tFrame: %.3f ms\n", check.recorded ? "RECORDED" : (passed ? "PASS" : "FAIL"),
+				renderCase->name, check.diff.mismatchedPixels, check.diff.totalPixels, check.diff.maxDifference, (double)check.frameNS / SDL_NS_PER_MS);
+		}
+	}
+
+	eng_destroyApplication(app);
+
+	return passed;
+}
+
+static const RenderCase *findCase(const char *name) {
+	for (uint32_t i = 0; i < SDL_arraysize(cases); i++) {
+		if (strcmp(cases[i].name, name) == 0) {
+			return &cases[i];
+		}
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	bool record = argc > 1 && strcmp(argv[1], "--record") == 0;
+	int first = record ? 2 : 1;
+
+	for (int i = first; i < argc; i++) {
+		if (findCase(argv[i]) == NULL) {
+			printf("Usage: %s [--record] [case...]\nUnknown case %s, the cases are:", argv[0], argv[i]);
+			for (uint32_t j = 0; j < SDL_arraysize(cases); j++) {
+				printf(" %s", cases[j].name);
+			}
+			printf("\n");
+			return 1;
+		}
+	}
+
+	if (eng_initHeadless(false) != SUCCESS) {
+		printf("%s\n", eng_getError());
+		return 1;
+	}
+
+	// tests/golden only exists once a golden image has been checked in
+	if (record && !SDL_CreateDirectory(GOLDEN_DIRECTORY)) {
+		printf("Failed to create %s: %s\n", GOLDEN_DIRECTORY, SDL_GetError());
+		eng_quit(NULL);
+		return 1;
+	}
+
+	uint32_t failed = 0;
+	if (first == argc) {
+		uint32_t skipped = 0;
+		for (uint32_t i = 0; i < SDL_arraysize(cases); i++) {
+			if (!record && !cases[i].recorded) {
+				printf("SKIP %s\tNo golden image recorded yet\n", cases[i].name);
+				skipped++;
+				continue;
+			}
+			failed += !runCase(&cases[i], record);
+		}
+		if (skipped > 0) {
+			printf("%u cases have no golden image, record them with %s --record\n", skipped, argv[0]);
+		}
+	} else {
+		for (int i = first; i < argc; i++) {
+			failed += !runCase(findCase(argv[i]), record);
+		}
+	}
+
+	eng_quit(NULL);
+
+	if (failed > 0) {
+		printf("%u render tests failed\n", failed);
+		return 1;
+	}
+
+	return 0;
+}
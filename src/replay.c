@@ -0,0 +1,266 @@
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "replay.h"
+
+#define RECORD_BUFFER_SIZE 65536
+
+static SDL_IOStream *recordFile = NULL;
+static uint8_t recordBuffer[RECORD_BUFFER_SIZE];
+static uint32_t recordLength = 0;
+static Mouse recordedMouse;
+static int recordedWidth = 0;
+static int recordedHeight = 0;
+
+static uint8_t *replayData = NULL;
+static size_t replaySize = 0;
+static size_t replayPosition = 0;
+
+static uint32_t frame = 0;
+
+static bool flushRecording() {
+	bool success = SDL_WriteIO(recordFile, recordBuffer, recordLength) == recordLength;
+	recordLength = 0;
+
+	return success;
+}
+
+static void writeBytes(const void *data, uint32_t size) {
+	if (recordLength + size > RECORD_BUFFER_SIZE) {
+		flushRecording();
+	}
+
+	memcpy(recordBuffer + recordLength, data, size);
+	recordLength += size;
+}
+
+static bool readBytes(void *data, size_t size) {
+	if (replayPosition + size > replaySize) {
+		return false;
+	}
+
+	memcpy(data, replayData + replayPosition, size);
+	replayPosition += size;
+
+	return true;
+}
+
+ENG_RESULT eng_startRecording(const char *path) {
+	if (path == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	eng_stopRecording();
+
+	recordFile = SDL_IOFromFile(path, "wb");
+	if (recordFile == NULL) {
+		return eng_setErrorDetail(FAILED_TO_OPEN_REPLAY, "%s", path);
+	}
+
+	eng_ReplayHeader header = (eng_ReplayHeader) {
+		.magic = ENG_REPLAY_MAGIC,
+		.version = ENG_REPLAY_VERSION,
+	};
+	writeBytes(&header, sizeof(header));
+
+	// Forces the first record to carry the mouse and window size
+	recordedMouse = (Mouse) {
+		.x = -1,
+		.y = -1,
+	};
+	recordedWidth = -1;
+	recordedHeight = -1;
+	frame = 0;
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_INPUT, "Recording input to %s", path);
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_stopRecording() {
+	if (recordFile == NULL) {
+		return SUCCESS;
+	}
+
+	bool success = flushRecording();
+	success = SDL_CloseIO(recordFile) && success;
+	recordFile = NULL;
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_INPUT, "Stopped recording after %d frames", frame);
+
+	if (!success) {
+		return eng_setError(FAILED_TO_OPEN_REPLAY);
+	}
+
+	return SUCCESS;
+}
+
+void eng_recordPoll(Application *app, bool result) {
+	if (recordFile == NULL) {
+		return;
+	}
+
+	uint8_t kind = ENG_REPLAY_FRAME_END;
+	if (!app->isRunning) {
+		kind = ENG_REPLAY_QUIT;
+	} else if (result) {
+		kind = ENG_REPLAY_EVENT;
+	}
+
+	uint8_t header = kind;
+	if (app->mouse.x != recordedMouse.x || app->mouse.y != recordedMouse.y) {
+		header |= ENG_REPLAY_MOUSE;
+		recordedMouse = app->mouse;
+	}
+	if (app->window->width != recordedWidth || app->window->height != recordedHeight) {
+		header |= ENG_REPLAY_SIZE;
+		recordedWidth = app->window->width;
+		recordedHeight = app->window->height;
+	}
+	writeBytes(&header, sizeof(header));
+
+	if (kind == ENG_REPLAY_EVENT) {
+		uint8_t type = app->event.type;
+		writeBytes(&type, sizeof(type));
+		writeBytes(&app->event.value, sizeof(app->event.value));
+	} else {
+		frame++;
+	}
+
+	if (header & ENG_REPLAY_MOUSE) {
+		writeBytes(&recordedMouse.x, sizeof(float));
+		writeBytes(&recordedMouse.y, sizeof(float));
+	}
+	if (header & ENG_REPLAY_SIZE) {
+		int32_t size[2] = {recordedWidth, recordedHeight};
+		writeBytes(size, sizeof(size));
+	}
+}
+
+ENG_RESULT eng_startReplay(const char *path) {
+	if (path == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	eng_stopReplay();
+
+	replayData = SDL_LoadFile(path, &replaySize);
+	if (replayData == NULL) {
+		return eng_setErrorDetail(FAILED_TO_OPEN_REPLAY, "%s", path);
+	}
+
+	eng_ReplayHeader header;
+	replayPosition = 0;
+	if (!readBytes(&header, sizeof(header)) || header.magic != ENG_REPLAY_MAGIC || header.version != ENG_REPLAY_VERSION) {
+		eng_stopReplay();
+		return eng_setErrorDetail(INVALID_REPLAY_FORMAT, "%s", path);
+	}
+	frame = 0;
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_INPUT, "Replaying input from %s", path);
+
+	return SUCCESS;
+}
+
+void eng_stopReplay() {
+	if (replayData == NULL) {
+		return;
+	}
+
+	SDL_free(replayData);
+	replayData = NULL;
+	replaySize = 0;
+	replayPosition = 0;
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_INPUT, "Stopped replay after %d frames", frame);
+}
+
+bool eng_isReplaying() {
+	return replayData != NULL;
+}
+
+uint32_t eng_getReplayFrame() {
+	return frame;
+}
+
+static bool endReplay(Application *app, bool *result) {
+	app->isRunning = false;
+	*result = false;
+	eng_stopReplay();
+
+	return true;
+}
+
+bool eng_replayPollEvent(Application *app, bool *result) {
+	if (replayData == NULL) {
+		return false;
+	}
+
+	// Real input is thrown away so it can't change the replay, closing the window still works
+	SDL_Event event;
+	while (SDL_PollEvent(&event)) {
+		if (event.type == SDL_EVENT_QUIT) {
+			return endReplay(app, result);
+		}
+	}
+
+	uint8_t header;
+	if (!readBytes(&header, sizeof(header))) {
+		return endReplay(app, result);
+	}
+
+	uint8_t kind = header & ENG_REPLAY_KIND_MASK;
+	if (kind == ENG_REPLAY_EVENT) {
+		uint8_t type;
+		uint32_t value;
+		if (!readBytes(&type, sizeof(type)) || !readBytes(&value, sizeof(value))) {
+			return endReplay(app, result);
+		}
+		app->event.type = type;
+		app->event.value = value;
+	}
+
+	if (header & ENG_REPLAY_MOUSE) {
+		if (!readBytes(&app->mouse.x, sizeof(float)) || !readBytes(&app->mouse.y, sizeof(float))) {
+			return endReplay(app, result);
+		}
+	}
+	if (header & ENG_REPLAY_SIZE) {
+		int32_t size[2];
+		if (!readBytes(size, sizeof(size))) {
+			return endReplay(app, result);
+		}
+
+		// The recorded size is the one the game saw, a virtual resolution on the replaying window already gives the game its size
+		if (eng_hasVirtualResolution(app->window)) {
+			eng_updateWindowSize(app->window);
+		} else {
+			app->window->width = size[0];
+			app->window->height = size[1];
+		}
+	}
+
+	switch (kind) {
+		case ENG_REPLAY_EVENT:
+			*result = true;
+			break;
+		case ENG_REPLAY_FRAME_END:
+			*result = false;
+			frame++;
+			break;
+		case ENG_REPLAY_QUIT:
+			return endReplay(app, result);
+		default:
+			eng_setError(INVALID_REPLAY_FORMAT);
+			return endReplay(app, result);
+	}
+
+	return true;
+}
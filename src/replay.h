@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "engine.h"
+
+/*
+* Input recording and replay, every result of eng_pollEvent is written to a binary log that can be fed back through eng_pollEvent later.
+*
+* A frame ends whenever eng_pollEvent returns false, so a replay reproduces the exact same frames. Replays ignore the fps limit so they can be used as benchmarks.
+*
+* Log layout (little endian): eng_ReplayHeader then one record per poll. A record is a kind byte, the event type and value for ENG_REPLAY_EVENT,
+* then the mouse position if ENG_REPLAY_MOUSE is set and the window size if ENG_REPLAY_SIZE is set. The size is the one the game saw, the virtual
+* resolution if there was one, and it's only replayed into windows without a virtual resolution.
+*/
+
+#define ENG_REPLAY_MAGIC 0x52474E45 // "ENGR"
+#define ENG_REPLAY_VERSION 1
+
+#define ENG_REPLAY_FRAME_END 0x01
+#define ENG_REPLAY_EVENT 0x02
+#define ENG_REPLAY_QUIT 0x03
+#define ENG_REPLAY_KIND_MASK 0x0F
+#define ENG_REPLAY_MOUSE 0x10
+#define ENG_REPLAY_SIZE 0x20
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+} eng_ReplayHeader;
+
+/*
+* Starts writing every poll to the file, anything already in the file is replaced
+*/
+ENG_RESULT eng_startRecording(const char *path);
+
+/*
+* Writes what's left of the log and closes the file, eng_quit calls this automatically
+*/
+ENG_RESULT eng_stopRecording();
+
+/*
+* Starts feeding the log back through eng_pollEvent, the Application stops running when the log ends
+*/
+ENG_RESULT eng_startReplay(const char *path);
+
+void eng_stopReplay();
+
+bool eng_isReplaying();
+
+/*
+* Returns how many frames have been recorded or replayed so far
+*/
+uint32_t eng_getReplayFrame();
+
+#endif
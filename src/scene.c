@@ -0,0 +1,738 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "scene.h"
+
+struct eng_SceneWriter {
+	eng_SceneAsset *assets;
+	uint32_t assetCount;
+	uint32_t assetCapacity;
+
+	eng_SceneObject *objects;
+	uint32_t objectCount;
+	uint32_t objectCapacity;
+
+	char *strings;
+	uint32_t stringSize;
+	uint32_t stringCapacity;
+};
+
+struct eng_Scene {
+	uint8_t *data;
+	size_t size;
+	bool mapped;
+
+	eng_SceneHeader *header;
+	eng_SceneAsset *assets;
+	eng_SceneObject *objects;
+	const char *strings;
+
+	SDL_Texture **textures;
+	TTF_Font **fonts;
+	SDL_Texture **texts;
+
+	// Images and text decoded off the main thread by eng_decodeSceneAssets, uploaded and freed by eng_uploadSceneAssets
+	SDL_Surface **surfaces;
+	SDL_Surface **textSurfaces; // Indexed by object
+	uint32_t nextAsset;
+	uint32_t nextText;
+};
+
+static bool grow(void **array, uint32_t *capacity, uint32_t needed, size_t elementSize) {
+	if (needed <= *capacity) {
+		return true;
+	}
+
+	uint32_t newCapacity = *capacity == 0 ? 64 : *capacity;
+	while (newCapacity < needed) {
+		newCapacity *= 2;
+	}
+
+	void *newArray = realloc(*array, newCapacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+
+	*array = newArray;
+	*capacity = newCapacity;
+
+	return true;
+}
+
+static uint32_t addString(eng_SceneWriter *writer, const char *string) {
+	if (string == NULL || string[0] == '\0') {
+		return 0;
+	}
+
+	uint32_t length = strlen(string) + 1;
+	if (!grow((void **)&writer->strings, &writer->stringCapacity, writer->stringSize + length, sizeof(char))) {
+		eng_setError(FAILED_TO_MALLOC);
+		return 0;
+	}
+
+	uint32_t offset = writer->stringSize;
+	memcpy(writer->strings + offset, string, length);
+	writer->stringSize += length;
+
+	return offset;
+}
+
+static uint32_t addAsset(eng_SceneWriter *writer, const char *path, uint32_t fontSize) {
+	for (uint32_t i = 0; i < writer->assetCount; i++) {
+		eng_SceneAsset *asset = &writer->assets[i];
+		if (asset->fontSize == fontSize && strcmp(writer->strings + asset->path, path) == 0) {
+			return i;
+		}
+	}
+
+	if (!grow((void **)&writer->assets, &writer->assetCapacity, writer->assetCount + 1, sizeof(eng_SceneAsset))) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_SCENE_NO_ASSET;
+	}
+
+	writer->assets[writer->assetCount] = (eng_SceneAsset) {
+		.path = addString(writer, path),
+		.fontSize = fontSize,
+	};
+
+	return writer->assetCount++;
+}
+
+static ENG_RESULT addObject(eng_SceneWriter *writer, eng_SceneObject object) {
+	if (!grow((void **)&writer->objects, &writer->objectCapacity, writer->objectCount + 1, sizeof(eng_SceneObject))) {
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+
+	writer->objects[writer->objectCount++] = object;
+
+	return SUCCESS;
+}
+
+eng_SceneWriter *eng_createSceneWriter() {
+	eng_SceneWriter *writer = (eng_SceneWriter *)calloc(1, sizeof(eng_SceneWriter));
+	if (writer == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	// Offset 0 is reserved for the empty string
+	if (!grow((void **)&writer->strings, &writer->stringCapacity, 1, sizeof(char))) {
+		eng_setError(FAILED_TO_MALLOC);
+		free(writer);
+		return NULL;
+	}
+	writer->strings[0] = '\0';
+	writer->stringSize = 1;
+
+	return writer;
+}
+
+uint32_t eng_sceneAddImageAsset(eng_SceneWriter *writer, const char *path) {
+	if (writer == NULL || path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_SCENE_NO_ASSET;
+	}
+
+	return addAsset(writer, path, 0);
+}
+
+uint32_t eng_sceneAddFontAsset(eng_SceneWriter *writer, const char *path, uint32_t fontSize) {
+	if (writer == NULL || path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_SCENE_NO_ASSET;
+	}
+
+	return addAsset(writer, path, fontSize == 0 ? 1 : fontSize);
+}
+
+ENG_RESULT eng_sceneAddRect(eng_SceneWriter *writer, float h, float w, float x, float y, eng_Color color) {
+	if (writer == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	return addObject(writer, (eng_SceneObject) {
+		.type = TYPE_RECT,
+		.asset = ENG_SCENE_NO_ASSET,
+		.h = h,
+		.w = w,
+		.x = x,
+		.y = y,
+		.color = eng_packColor(color),
+	});
+}
+
+ENG_RESULT eng_sceneAddImage(eng_SceneWriter *writer, uint32_t asset, float h, float w, float x, float y, uint16_t srcX, uint16_t srcY, uint16_t srcW, uint16_t srcH) {
+	if (writer == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (asset >= writer->assetCount || writer->assets[asset].fontSize != 0) {
+		return eng_setError(INVALID_SCENE_FORMAT);
+	}
+
+	return addObject(writer, (eng_SceneObject) {
+		.type = TYPE_TEXTURE,
+		.asset = asset,
+		.h = h,
+		.w = w,
+		.x = x,
+		.y = y,
+		.color = 0xFFFFFFFF,
+		.srcX = srcX,
+		.srcY = srcY,
+		.srcW = srcW,
+		.srcH = srcH,
+	});
+}
+
+ENG_RESULT eng_sceneAddText(eng_SceneWriter *writer, uint32_t fontAsset, const char *text, eng_Color color, float x, float y) {
+	if (writer == NULL || text == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (fontAsset >= writer->assetCount || writer->assets[fontAsset].fontSize == 0) {
+		return eng_setError(INVALID_SCENE_FORMAT);
+	}
+
+	return addObject(writer, (eng_SceneObject) {
+		.type = TYPE_TEXT,
+		.asset = fontAsset,
+		.x = x,
+		.y = y,
+		.color = eng_packColor(color),
+		.text = addString(writer, text),
+	});
+}
+
+ENG_RESULT eng_writeScene(eng_SceneWriter *writer, const char *path) {
+	if (writer == NULL || path == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	uint32_t assetSize = writer->assetCount * sizeof(eng_SceneAsset);
+	uint32_t objectSize = writer->objectCount * sizeof(eng_SceneObject);
+
+	eng_SceneHeader header = (eng_SceneHeader) {
+		.magic = ENG_SCENE_MAGIC,
+		.version = ENG_SCENE_VERSION,
+		.assetCount = writer->assetCount,
+		.objectCount = writer->objectCount,
+		.assetOffset = sizeof(eng_SceneHeader),
+		.objectOffset = sizeof(eng_SceneHeader) + assetSize,
+		.stringOffset = sizeof(eng_SceneHeader) + assetSize + objectSize,
+		.stringSize = writer->stringSize,
+	};
+
+	SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+	if (file == NULL) {
+		return eng_setError(FAILED_TO_WRITE_SCENE);
+	}
+
+	bool success = SDL_WriteIO(file, &header, sizeof(header)) == sizeof(header)
+		&& SDL_WriteIO(file, writer->assets, assetSize) == assetSize
+		&& SDL_WriteIO(file, writer->objects, objectSize) == objectSize
+		&& SDL_WriteIO(file, writer->strings, writer->stringSize) == writer->stringSize;
+
+	if (!SDL_CloseIO(file) || !success) {
+		return eng_setError(FAILED_TO_WRITE_SCENE);
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Wrote scene %s\tAssets: %d\tObjects: %d", path, writer->assetCount, writer->objectCount);
+
+	return SUCCESS;
+}
+
+void eng_destroySceneWriter(eng_SceneWriter *writer) {
+	if (writer == NULL) {
+		return;
+	}
+
+	free(writer->assets);
+	free(writer->objects);
+	free(writer->strings);
+	free(writer);
+}
+
+static bool isSectionInFile(eng_Scene *scene, uint32_t offset, uint64_t size) {
+	return offset % 4 == 0 && (uint64_t)offset + size <= scene->size;
+}
+
+static bool validateScene(eng_Scene *scene) {
+	if (scene->size < sizeof(eng_SceneHeader)) {
+		return false;
+	}
+
+	eng_SceneHeader *header = scene->header;
+	if (header->magic != ENG_SCENE_MAGIC || header->version != ENG_SCENE_VERSION) {
+		return false;
+	}
+
+	if (!isSectionInFile(scene, header->assetOffset, (uint64_t)header->assetCount * sizeof(eng_SceneAsset))
+		|| !isSectionInFile(scene, header->objectOffset, (uint64_t)header->objectCount * sizeof(eng_SceneObject))
+		|| (uint64_t)header->stringOffset + header->stringSize > scene->size) {
+		return false;
+	}
+
+	if (header->stringSize == 0 || scene->strings[header->stringSize - 1] != '\0') {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < header->assetCount; i++) {
+		if (scene->assets[i].path >= header->stringSize) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < header->objectCount; i++) {
+		eng_SceneObject *object = &scene->objects[i];
+		if (object->text >= header->stringSize) {
+			return false;
+		}
+
+		switch (object->type) {
+			case TYPE_RECT:
+				break;
+			case TYPE_TEXTURE:
+				if (object->asset >= header->assetCount || scene->assets[object->asset].fontSize != 0) {
+					return false;
+				}
+				break;
+			case TYPE_TEXT:
+				if (object->asset >= header->assetCount || scene->assets[object->asset].fontSize == 0) {
+					return false;
+				}
+				break;
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+eng_Scene *eng_openScene(const char *path) {
+	if (path == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	eng_Scene *scene = (eng_Scene *)calloc(1, sizeof(eng_Scene));
+	if (scene == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+#ifdef _WIN32
+	scene->data = SDL_LoadFile(path, &scene->size);
+	if (scene->data == NULL) {
+		eng_setErrorDetail(FAILED_TO_OPEN_SCENE, "%s", path);
+		free(scene);
+		return NULL;
+	}
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		eng_setErrorDetail(FAILED_TO_OPEN_SCENE, "%s", path);
+		free(scene);
+		return NULL;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		eng_setErrorDetail(info.st_size == 0 ? INVALID_SCENE_FORMAT : FAILED_TO_OPEN_SCENE, "%s", path);
+		close(fd);
+		free(scene);
+		return NULL;
+	}
+	scene->size = info.st_size;
+
+	// Private mapping so games can move objects around without writing back to the file
+	void *data = mmap(NULL, scene->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		eng_setErrorDetail(FAILED_TO_OPEN_SCENE, "%s", path);
+		free(scene);
+		return NULL;
+	}
+	scene->data = data;
+	scene->mapped = true;
+#endif
+
+	scene->header = (eng_SceneHeader *)scene->data;
+	if (scene->size >= sizeof(eng_SceneHeader)) {
+		scene->assets = (eng_SceneAsset *)(scene->data + scene->header->assetOffset);
+		scene->objects = (eng_SceneObject *)(scene->data + scene->header->objectOffset);
+		scene->strings = (const char *)(scene->data + scene->header->stringOffset);
+	}
+
+	if (!validateScene(scene)) {
+		eng_setErrorDetail(INVALID_SCENE_FORMAT, "%s", path);
+		eng_destroyScene(scene);
+		return NULL;
+	}
+
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Opened scene %s\tAssets: %d\tObjects: %d", path, scene->header->assetCount, scene->header->objectCount);
+
+	return scene;
+}
+
+static SDL_Surface *renderSceneText(eng_Scene *scene, TTF_Font *font, uint32_t index) {
+	eng_SceneObject *object = &scene->objects[index];
+	const char *text = scene->strings + object->text;
+	eng_Color color = eng_unpackColor(object->color);
+
+	SDL_Color selectedColor = (SDL_Color) {
+		.r = color.r,
+		.g = color.g,
+		.b = color.b,
+		.a = color.a,
+	};
+
+	return TTF_RenderText_Blended(font, text, strlen(text), selectedColor);
+}
+
+static ENG_RESULT createSceneText(Window *window, eng_Scene *scene, uint32_t index) {
+	eng_SceneObject *object = &scene->objects[index];
+
+	SDL_Surface *surface;
+	if (scene->textSurfaces != NULL) {
+		surface = scene->textSurfaces[index];
+		scene->textSurfaces[index] = NULL;
+	} else {
+		surface = renderSceneText(scene, scene->fonts[object->asset], index);
+	}
+	if (surface == NULL) {
+		return eng_setError(FAILED_TO_CREATE_FONT_RENDER);
+	}
+
+	if (object->w == 0 || object->h == 0) {
+		object->w = surface->w;
+		object->h = surface->h;
+	}
+
+	// Simulations without a renderer only keep the text's size
+	if (window->pRenderer == NULL) {
+		SDL_DestroySurface(surface);
+		return SUCCESS;
+	}
+
+	scene->texts[index] = eng_createTextureFromSurface(window->pRenderer, surface);
+	SDL_DestroySurface(surface);
+
+	if (scene->texts[index] == NULL) {
+		return eng_setError(FAILED_TO_CONVERT_FONT_TO_TEXTURE);
+	}
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_decodeSceneAssets(eng_Scene *scene) {
+	if (scene == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	uint32_t assetCount = scene->header->assetCount;
+	uint32_t objectCount = scene->header->objectCount;
+	scene->surfaces = (SDL_Surface **)calloc(assetCount + 1, sizeof(SDL_Surface *));
+	TTF_Font **fonts = (TTF_Font **)calloc(assetCount + 1, sizeof(TTF_Font *));
+	if (scene->surfaces == NULL || fonts == NULL) {
+		free(fonts);
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+
+	// Fonts opened here belong to this thread, they're closed once the text is rendered so the main thread only creates textures
+	bool hasText = false;
+	for (uint32_t i = 0; i < objectCount && !hasText; i++) {
+		hasText = scene->objects[i].type == TYPE_TEXT;
+	}
+	for (uint32_t i = 0; i < assetCount; i++) {
+		const char *path = scene->strings + scene->assets[i].path;
+		if (scene->assets[i].fontSize == 0) {
+			scene->surfaces[i] = IMG_Load(path);
+		} else if (hasText) {
+			fonts[i] = TTF_OpenFont(path, scene->assets[i].fontSize);
+		}
+	}
+
+	if (hasText) {
+		scene->textSurfaces = (SDL_Surface **)calloc(objectCount, sizeof(SDL_Surface *));
+		for (uint32_t i = 0; i < objectCount && scene->textSurfaces != NULL; i++) {
+			eng_SceneObject *object = &scene->objects[i];
+			if (object->type == TYPE_TEXT && object->asset < assetCount && fonts[object->asset] != NULL) {
+				scene->textSurfaces[i] = renderSceneText(scene, fonts[object->asset], i);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < assetCount; i++) {
+		if (fonts[i] != NULL) {
+			TTF_CloseFont(fonts[i]);
+		}
+	}
+	free(fonts);
+
+	if (hasText && scene->textSurfaces == NULL) {
+		return eng_setError(FAILED_TO_MALLOC);
+	}
+
+	return SUCCESS;
+}
+
+static ENG_RESULT loadSceneAsset(Window *window, eng_Scene *scene, uint32_t index) {
+	eng_SceneAsset *asset = &scene->assets[index];
+	const char *path = scene->strings + asset->path;
+
+	// A decoded scene has everything read from disk already, whatever failed to decode fails here instead of being read on the main thread
+	if (scene->surfaces != NULL) {
+		if (asset->fontSize != 0) {
+			return SUCCESS;
+		}
+
+		if (scene->surfaces[index] == NULL) {
+			return eng_setErrorDetail(FAILED_TO_LOAD_IMAGE, "%s", path);
+		}
+
+		if (window->pRenderer == NULL) {
+			SDL_DestroySurface(scene->surfaces[index]);
+			scene->surfaces[index] = NULL;
+			return SUCCESS;
+		}
+
+		scene->textures[index] = eng_acquireTextureFromSurface(window->pRenderer, path, scene->surfaces[index]);
+		SDL_DestroySurface(scene->surfaces[index]);
+		scene->surfaces[index] = NULL;
+
+		return scene->textures[index] != NULL ? SUCCESS : FAILED_TO_LOAD_IMAGE;
+	}
+
+	if (asset->fontSize != 0) {
+		scene->fonts[index] = eng_acquireFont(path, asset->fontSize);
+		return scene->fonts[index] != NULL ? SUCCESS : FAILED_TO_OPEN_FONT;
+	}
+
+	// Simulations without a renderer keep the objects' sizes and positions but never load their images
+	if (window->pRenderer == NULL) {
+		return SUCCESS;
+	}
+
+	scene->textures[index] = eng_acquireTexture(window->pRenderer, path);
+
+	return scene->textures[index] != NULL ? SUCCESS : FAILED_TO_LOAD_IMAGE;
+}
+
+ENG_RESULT eng_uploadSceneAssets(Window *window, eng_Scene *scene, uint64_t deadlineNS, bool *done) {
+	if (done != NULL) {
+		*done = false;
+	}
+
+	if (window == NULL || scene == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	uint32_t assetCount = scene->header->assetCount;
+	uint32_t objectCount = scene->header->objectCount;
+
+	if (scene->textures == NULL) {
+		scene->textures = (SDL_Texture **)calloc(assetCount + 1, sizeof(SDL_Texture *));
+		scene->fonts = (TTF_Font **)calloc(assetCount + 1, sizeof(TTF_Font *));
+		if (scene->textures == NULL || scene->fonts == NULL) {
+			return eng_setError(FAILED_TO_MALLOC);
+		}
+
+		bool hasText = false;
+		for (uint32_t i = 0; i < objectCount && !hasText; i++) {
+			hasText = scene->objects[i].type == TYPE_TEXT;
+		}
+
+		if (hasText) {
+			scene->texts = (SDL_Texture **)calloc(objectCount, sizeof(SDL_Texture *));
+			if (scene->texts == NULL) {
+				return eng_setError(FAILED_TO_MALLOC);
+			}
+		}
+	}
+
+	// Always does at least one step so a short deadline can't stall the upload
+	while (scene->nextAsset < assetCount) {
+		ENG_RESULT result = loadSceneAsset(window, scene, scene->nextAsset++);
+		if (result != SUCCESS) {
+			return result;
+		}
+
+		if (SDL_GetTicksNS() >= deadlineNS) {
+			return SUCCESS;
+		}
+	}
+
+	while (scene->texts != NULL && scene->nextText < objectCount) {
+		uint32_t index = scene->nextText++;
+		if (scene->objects[index].type != TYPE_TEXT) {
+			continue;
+		}
+
+		ENG_RESULT result = createSceneText(window, scene, index);
+		if (result != SUCCESS) {
+			return result;
+		}
+
+		if (SDL_GetTicksNS() >= deadlineNS) {
+			return SUCCESS;
+		}
+	}
+
+	if (done != NULL) {
+		*done = true;
+	}
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_loadSceneAssets(Window *window, eng_Scene *scene) {
+	return eng_uploadSceneAssets(window, scene, UINT64_MAX, NULL);
+}
+
+eng_Scene *eng_loadScene(Window *window, const char *path) {
+	eng_Scene *scene = eng_openScene(path);
+	if (scene == NULL) {
+		return NULL;
+	}
+
+	if (eng_loadSceneAssets(window, scene) != SUCCESS) {
+		eng_destroyScene(scene);
+		return NULL;
+	}
+
+	return scene;
+}
+
+eng_SceneObject *eng_getSceneObjects(eng_Scene *scene, uint32_t *count) {
+	if (scene == NULL) {
+		eng_setError(DATA_IS_NULL);
+		if (count) {
+			*count = 0;
+		}
+		return NULL;
+	}
+
+	if (count) {
+		*count = scene->header->objectCount;
+	}
+
+	return scene->objects;
+}
+
+void eng_renderScene(SDL_Renderer *renderer, eng_Scene *scene) {
+	eng_renderSceneOffset(renderer, scene, 0, 0);
+}
+
+void eng_renderSceneOffset(SDL_Renderer *renderer, eng_Scene *scene, float offsetX, float offsetY) {
+	if (scene->textures == NULL) {
+		return;
+	}
+
+	uint32_t assetCount = scene->header->assetCount;
+	uint32_t objectCount = scene->header->objectCount;
+	eng_countDrawCalls(objectCount, 0);
+
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+	for (uint32_t i = 0; i < objectCount; i++) {
+		eng_SceneObject *object = &scene->objects[i];
+		SDL_FRect rect = (SDL_FRect) {
+			.h = object->h,
+			.w = object->w,
+			.x = object->x + offsetX,
+			.y = object->y + offsetY,
+		};
+
+		if (object->type == TYPE_RECT) {
+			SDL_SetRenderDrawBlendMode(renderer, (object->color & 0xFF) < 255 ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+			SDL_SetRenderDrawColor(renderer, object->color >> 24, (object->color >> 16) & 0xFF, (object->color >> 8) & 0xFF, object->color & 0xFF);
+			SDL_RenderFillRect(renderer, &rect);
+		} else if (object->type == TYPE_TEXTURE && object->asset < assetCount) {
+			if (object->srcW != 0 && object->srcH != 0) {
+				SDL_FRect src = (SDL_FRect) {
+					.h = object->srcH,
+					.w = object->srcW,
+					.x = object->srcX,
+					.y = object->srcY,
+				};
+				SDL_RenderTexture(renderer, scene->textures[object->asset], &src, &rect);
+			} else {
+				SDL_RenderTexture(renderer, scene->textures[object->asset], NULL, &rect);
+			}
+		} else if (object->type == TYPE_TEXT && scene->texts != NULL) {
+			SDL_RenderTexture(renderer, scene->texts[i], NULL, &rect);
+		}
+	}
+	SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+}
+
+void eng_destroyScene(eng_Scene *scene) {
+	if (scene == NULL) {
+		return;
+	}
+
+	if (scene->texts) {
+		for (uint32_t i = 0; i < scene->header->objectCount; i++) {
+			eng_destroyTexture(scene->texts[i]);
+		}
+		free(scene->texts);
+	}
+
+	if (scene->textures) {
+		for (uint32_t i = 0; i < scene->header->assetCount; i++) {
+			eng_releaseTexture(scene->textures[i]);
+		}
+		free(scene->textures);
+	}
+
+	if (scene->surfaces) {
+		for (uint32_t i = 0; i < scene->header->assetCount; i++) {
+			SDL_DestroySurface(scene->surfaces[i]);
+		}
+		free(scene->surfaces);
+	}
+
+	if (scene->textSurfaces) {
+		for (uint32_t i = 0; i < scene->header->objectCount; i++) {
+			SDL_DestroySurface(scene->textSurfaces[i]);
+		}
+		free(scene->textSurfaces);
+	}
+
+	if (scene->fonts) {
+		for (uint32_t i = 0; i < scene->header->assetCount; i++) {
+			if (scene->fonts[i]) {
+				eng_releaseFont(scene->fonts[i]);
+			}
+		}
+		free(scene->fonts);
+	}
+
+#ifdef _WIN32
+	SDL_free(scene->data);
+#else
+	if (scene->mapped) {
+		munmap(scene->data, scene->size);
+	}
+#endif
+
+	free(scene);
+}
@@ -0,0 +1,136 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "engine.h"
+
+/*
+* Binary scene files, the file is mapped into memory and used in place so loading doesn't create objects one at a time.
+*
+* Layout (little endian, every section is 4 byte aligned):
+*   eng_SceneHeader
+*   eng_SceneAsset[assetCount]   the atlas, objects point into this with an index
+*   eng_SceneObject[objectCount]
+*   string table                 NUL terminated paths and text, offset 0 is always the empty string
+*/
+
+#define ENG_SCENE_MAGIC 0x53474E45 // "ENGS"
+#define ENG_SCENE_VERSION 1
+#define ENG_SCENE_NO_ASSET 0xFFFFFFFF
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t assetCount;
+	uint32_t objectCount;
+	uint32_t assetOffset;
+	uint32_t objectOffset;
+	uint32_t stringOffset;
+	uint32_t stringSize;
+} eng_SceneHeader;
+
+typedef struct {
+	uint32_t path;
+	uint32_t fontSize;
+} eng_SceneAsset;
+
+typedef struct {
+	uint32_t type;
+	uint32_t asset;
+	float h;
+	float w;
+	float x;
+	float y;
+	uint32_t color;
+	uint32_t text;
+	uint16_t srcX;
+	uint16_t srcY;
+	uint16_t srcW;
+	uint16_t srcH;
+} eng_SceneObject;
+
+typedef struct eng_Scene eng_Scene;
+typedef struct eng_SceneWriter eng_SceneWriter;
+
+/*
+* Creates an empty scene writer, add assets and objects to it and then save it with eng_writeScene
+*/
+eng_SceneWriter *eng_createSceneWriter();
+
+/*
+* Adds an image to the scene's atlas and returns its index, adding the same path twice returns the same index
+*/
+uint32_t eng_sceneAddImageAsset(eng_SceneWriter *writer, const char *path);
+
+/*
+* Adds a font at a specific size to the scene's atlas and returns its index
+*/
+uint32_t eng_sceneAddFontAsset(eng_SceneWriter *writer, const char *path, uint32_t fontSize);
+
+ENG_RESULT eng_sceneAddRect(eng_SceneWriter *writer, float h, float w, float x, float y, eng_Color color);
+
+/*
+* Adds an image object, set srcW and srcH to 0 to use the whole image or set them to a single frame of a sprite sheet
+*/
+ENG_RESULT eng_sceneAddImage(eng_SceneWriter *writer, uint32_t asset, float h, float w, float x, float y, uint16_t srcX, uint16_t srcY, uint16_t srcW, uint16_t srcH);
+
+/*
+* Adds a text object, the size is measured when the scene is loaded
+*/
+ENG_RESULT eng_sceneAddText(eng_SceneWriter *writer, uint32_t fontAsset, const char *text, eng_Color color, float x, float y);
+
+/*
+* Saves the scene to disk, the writer can keep being used afterwards
+*/
+ENG_RESULT eng_writeScene(eng_SceneWriter *writer, const char *path);
+
+void eng_destroySceneWriter(eng_SceneWriter *writer);
+
+/*
+* Maps a scene file into memory and checks it, this doesn't touch the renderer so it's safe to call off the main thread
+*/
+eng_Scene *eng_openScene(const char *path);
+
+/*
+* Creates the textures for every asset in the scene, each asset is only loaded once no matter how many objects use it
+*/
+ENG_RESULT eng_loadSceneAssets(Window *window, eng_Scene *scene);
+
+/*
+* Decodes the scene's images and renders its text into surfaces with fonts opened and closed on the calling thread. Like eng_openScene
+* this doesn't touch the renderer or the shared caches so it's meant for a loading thread
+*/
+ENG_RESULT eng_decodeSceneAssets(eng_Scene *scene);
+
+/*
+* Creates the scene's textures, fonts and text a piece at a time until SDL_GetTicksNS passes deadlineNS and carries on from there
+* the next time it's called. done is set once everything is created. After eng_decodeSceneAssets only textures are created, nothing is
+* read from disk and an asset that failed to decode fails the upload
+*/
+ENG_RESULT eng_uploadSceneAssets(Window *window, eng_Scene *scene, uint64_t deadlineNS, bool *done);
+
+/*
+* Opens the scene and loads its assets, add the result to a render queue with TYPE_SCENE to draw it
+*/
+eng_Scene *eng_loadScene(Window *window, const char *path);
+
+/*
+* Returns the objects inside the mapped file, changes to them are private to this process and show up on the next render
+*/
+eng_SceneObject *eng_getSceneObjects(eng_Scene *scene, uint32_t *count);
+
+/*
+* Draws every object in the scene, this is called by the render queue for TYPE_SCENE
+*/
+void eng_renderScene(SDL_Renderer *renderer, eng_Scene *scene);
+
+/*
+* Draws the scene moved by offsetX and offsetY, for scenes placed in a scrolling world
+*/
+void eng_renderSceneOffset(SDL_Renderer *renderer, eng_Scene *scene, float offsetX, float offsetY);
+
+/*
+* Unmaps the file and destroys every texture the scene created
+*/
+void eng_destroyScene(eng_Scene *scene);
+
+#endif
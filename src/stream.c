@@ -0,0 +1,491 @@
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "scene.h"
+#include "stream.h"
+
+typedef struct StreamJob {
+	struct StreamJob *pNext;
+	uint32_t chunk;
+	char path[512];
+	eng_Scene *scene; // NULL once loaded if the chunk has no file
+	SDL_AtomicInt cancelled;
+} StreamJob;
+
+typedef struct {
+	uint32_t chunk;
+	float distance;
+} ChunkRequest;
+
+typedef struct {
+	int32_t left;
+	int32_t top;
+	int32_t right;
+	int32_t bottom;
+} ChunkRange;
+
+struct eng_World {
+	Window *window;
+	char *pathFormat;
+	uint32_t columns;
+	uint32_t rows;
+	float chunkSize;
+	uint32_t loadRadius;
+	uint64_t uploadBudgetNS;
+	float viewX;
+	float viewY;
+	ChunkRange kept; // Every chunk that isn't unloaded is inside it
+
+	// One entry per chunk, job is set while the loading thread has the chunk
+	uint8_t *states;
+	eng_Scene **scenes;
+	StreamJob **jobs;
+
+	// Decoded chunks waiting for their textures, oldest first
+	uint32_t *uploads;
+	uint32_t uploadCount;
+
+	ChunkRequest *requests;
+
+	SDL_Thread *loader;
+	SDL_Semaphore *wake;
+	SDL_AtomicInt running;
+
+	// Lock free stacks between the threads, each side takes the whole stack at once
+	void *pendingJobs;
+	void *finishedJobs;
+
+	eng_WorldStats stats;
+};
+
+static void pushJob(void **stack, StreamJob *job) {
+	do {
+		job->pNext = SDL_GetAtomicPointer(stack);
+	} while (!SDL_CompareAndSwapAtomicPointer(stack, job->pNext, job));
+}
+
+static StreamJob *takeJobs(void **stack) {
+	StreamJob *jobs;
+	do {
+		jobs = SDL_GetAtomicPointer(stack);
+	} while (!SDL_CompareAndSwapAtomicPointer(stack, jobs, NULL));
+
+	// The stack hands them back newest first
+	StreamJob *ordered = NULL;
+	while (jobs != NULL) {
+		StreamJob *next = jobs->pNext;
+		jobs->pNext = ordered;
+		ordered = jobs;
+		jobs = next;
+	}
+
+	return ordered;
+}
+
+static void freeJob(StreamJob *job) {
+	eng_destroyScene(job->scene);
+	free(job);
+}
+
+static void freeJobs(StreamJob *jobs) {
+	while (jobs != NULL) {
+		StreamJob *next = jobs->pNext;
+		freeJob(jobs);
+		jobs = next;
+	}
+}
+
+// Runs on the loading thread, only maps, decodes and renders text so the renderer and the shared caches are never touched here
+static void loadJob(StreamJob *job) {
+	SDL_PathInfo info;
+	if (SDL_GetAtomicInt(&job->cancelled) || !SDL_GetPathInfo(job->path, &info)) {
+		return;
+	}
+
+	job->scene = eng_openScene(job->path);
+	if (job->scene == NULL) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Failed to open chunk %s, it's left empty", job->path);
+		return;
+	}
+
+	// An undecoded scene would make the main thread read its files, so a chunk that can't be decoded is left empty
+	if (!SDL_GetAtomicInt(&job->cancelled) && eng_decodeSceneAssets(job->scene) != SUCCESS) {
+		eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Failed to decode chunk %s, it's left empty", job->path);
+		eng_destroyScene(job->scene);
+		job->scene = NULL;
+	}
+}
+
+static int loadThread(void *data) {
+	eng_World *world = data;
+
+	while (true) {
+		SDL_WaitSemaphore(world->wake);
+		if (!SDL_GetAtomicInt(&world->running)) {
+			break;
+		}
+
+		StreamJob *jobs = takeJobs(&world->pendingJobs);
+		while (jobs != NULL) {
+			StreamJob *next = jobs->pNext;
+			if (!SDL_GetAtomicInt(&world->running)) {
+				SDL_SetAtomicInt(&jobs->cancelled, 1);
+			}
+			loadJob(jobs);
+			pushJob(&world->finishedJobs, jobs);
+			jobs = next;
+		}
+	}
+
+	return 0;
+}
+
+// The format is passed to snprintf later, so it has to hold exactly two %u and nothing else but %%
+static bool isChunkPathFormat(const char *format) {
+	uint32_t conversions = 0;
+	for (const char *c = format; *c != '\0'; c++) {
+		if (*c != '%') {
+			continue;
+		}
+
+		c++;
+		if (*c == 'u') {
+			conversions++;
+		} else if (*c != '%') {
+			return false;
+		}
+	}
+
+	return conversions == 2;
+}
+
+eng_World *eng_createWorld(Window *window, const char *pathFormat, uint32_t columns, uint32_t rows, float chunkSize, uint32_t loadRadius) {
+	if (window == NULL || pathFormat == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	if (columns == 0 || rows == 0 || chunkSize <= 0) {
+		eng_setError(INVALID_WORLD_SIZE);
+		return NULL;
+	}
+
+	if (!isChunkPathFormat(pathFormat)) {
+		eng_setErrorDetail(INVALID_CHUNK_PATH, "%s", pathFormat);
+		return NULL;
+	}
+
+	eng_World *world = (eng_World *)calloc(1, sizeof(eng_World));
+	if (world == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	uint32_t chunkCount = columns * rows;
+	*world = (eng_World) {
+		.window = window,
+		.pathFormat = SDL_strdup(pathFormat),
+		.columns = columns,
+		.rows = rows,
+		.chunkSize = chunkSize,
+		.loadRadius = loadRadius,
+		.uploadBudgetNS = (uint64_t)(ENG_WORLD_UPLOAD_MS * SDL_NS_PER_MS),
+		.states = (uint8_t *)calloc(chunkCount, sizeof(uint8_t)),
+		.scenes = (eng_Scene **)calloc(chunkCount, sizeof(eng_Scene *)),
+		.jobs = (StreamJob **)calloc(chunkCount, sizeof(StreamJob *)),
+		.uploads = (uint32_t *)malloc(chunkCount * sizeof(uint32_t)),
+		.requests = (ChunkRequest *)malloc(chunkCount * sizeof(ChunkRequest)),
+		.wake = SDL_CreateSemaphore(0),
+		.kept = (ChunkRange) {
+			.left = 0,
+			.top = 0,
+			.right = -1,
+			.bottom = -1,
+		},
+	};
+
+	if (world->pathFormat == NULL || world->states == NULL || world->scenes == NULL || world->jobs == NULL || world->uploads == NULL
+		|| world->requests == NULL) {
+		eng_destroyWorld(world);
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	SDL_SetAtomicInt(&world->running, 1);
+	world->loader = world->wake != NULL ? SDL_CreateThread(loadThread, "eng_stream", world) : NULL;
+	if (world->loader == NULL) {
+		eng_destroyWorld(world);
+		eng_setError(FAILED_TO_START_THREAD);
+		return NULL;
+	}
+
+	eng_trackMemory(ENG_MEMORY_POOLS, (int64_t)chunkCount * (sizeof(uint8_t) + sizeof(eng_Scene *) + sizeof(StreamJob *)
+		+ sizeof(uint32_t) + sizeof(ChunkRequest)), 1);
+	eng_log(ENG_LOG_DEBUG, ENG_LOG_ASSET, "Created world %s\tChunks: %ux%u\tLoad radius: %u", pathFormat, columns, rows, loadRadius);
+
+	return world;
+}
+
+void eng_setWorldUploadBudget(eng_World *world, float milliseconds) {
+	world->uploadBudgetNS = (uint64_t)(SDL_max(milliseconds, 0) * SDL_NS_PER_MS);
+}
+
+// The chunks the view covers grown by margin chunks on every side, clamped to the world
+static ChunkRange getChunkRange(eng_World *world, uint32_t margin) {
+	float right = world->viewX + world->window->width;
+	float bottom = world->viewY + world->window->height;
+
+	return (ChunkRange) {
+		.left = SDL_max((int32_t)SDL_floorf(world->viewX / world->chunkSize) - (int32_t)margin, 0),
+		.top = SDL_max((int32_t)SDL_floorf(world->viewY / world->chunkSize) - (int32_t)margin, 0),
+		.right = SDL_min((int32_t)SDL_floorf(right / world->chunkSize) + (int32_t)margin, (int32_t)world->columns - 1),
+		.bottom = SDL_min((int32_t)SDL_floorf(bottom / world->chunkSize) + (int32_t)margin, (int32_t)world->rows - 1),
+	};
+}
+
+static bool inRange(ChunkRange range, uint32_t column, uint32_t row) {
+	return (int32_t)column >= range.left && (int32_t)column <= range.right && (int32_t)row >= range.top && (int32_t)row <= range.bottom;
+}
+
+static void removeUpload(eng_World *world, uint32_t chunk) {
+	for (uint32_t i = 0; i < world->uploadCount; i++) {
+		if (world->uploads[i] == chunk) {
+			memmove(&world->uploads[i], &world->uploads[i + 1], (world->uploadCount - i - 1) * sizeof(uint32_t));
+			world->uploadCount--;
+			return;
+		}
+	}
+}
+
+static void unloadChunk(eng_World *world, uint32_t chunk) {
+	if (world->states[chunk] == ENG_CHUNK_LOADING) {
+		// The loading thread still owns the job, it comes back finished and is thrown away then
+		SDL_SetAtomicInt(&world->jobs[chunk]->cancelled, 1);
+		world->jobs[chunk] = NULL;
+		world->stats.cancelled++;
+	} else {
+		if (world->states[chunk] == ENG_CHUNK_UPLOADING) {
+			removeUpload(world, chunk);
+		}
+		eng_destroyScene(world->scenes[chunk]);
+		world->scenes[chunk] = NULL;
+		world->stats.chunksUnloaded++;
+	}
+
+	world->states[chunk] = ENG_CHUNK_UNLOADED;
+}
+
+static int compareRequests(const void *a, const void *b) {
+	float distanceA = ((const ChunkRequest *)a)->distance;
+	float distanceB = ((const ChunkRequest *)b)->distance;
+
+	return (distanceA > distanceB) - (distanceA < distanceB);
+}
+
+static void requestChunks(eng_World *world, ChunkRange range) {
+	float centerX = world->viewX + world->window->width / 2.0f;
+	float centerY = world->viewY + world->window->height / 2.0f;
+
+	uint32_t count = 0;
+	for (int32_t row = range.top; row <= range.bottom; row++) {
+		for (int32_t column = range.left; column <= range.right; column++) {
+			uint32_t chunk = row * world->columns + column;
+			if (world->states[chunk] != ENG_CHUNK_UNLOADED) {
+				continue;
+			}
+
+			float dx = (column + 0.5f) * world->chunkSize - centerX;
+			float dy = (row + 0.5f) * world->chunkSize - centerY;
+			world->requests[count++] = (ChunkRequest) {
+				.chunk = chunk,
+				.distance = dx * dx + dy * dy,
+			};
+		}
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	// The thread works through them in order so the chunks under the camera show up first
+	qsort(world->requests, count, sizeof(ChunkRequest), compareRequests);
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t chunk = world->requests[i].chunk;
+		StreamJob *job = (StreamJob *)calloc(1, sizeof(StreamJob));
+		if (job == NULL) {
+			eng_setError(FAILED_TO_MALLOC);
+			break;
+		}
+
+		job->chunk = chunk;
+		snprintf(job->path, sizeof(job->path), world->pathFormat, chunk % world->columns, chunk / world->columns);
+
+		world->jobs[chunk] = job;
+		world->states[chunk] = ENG_CHUNK_LOADING;
+		pushJob(&world->pendingJobs, job);
+	}
+
+	SDL_SignalSemaphore(world->wake);
+}
+
+static void receiveChunks(eng_World *world) {
+	StreamJob *jobs = takeJobs(&world->finishedJobs);
+	while (jobs != NULL) {
+		StreamJob *job = jobs;
+		jobs = job->pNext;
+
+		if (SDL_GetAtomicInt(&job->cancelled) || world->jobs[job->chunk] != job) {
+			freeJob(job);
+			continue;
+		}
+
+		world->jobs[job->chunk] = NULL;
+		world->scenes[job->chunk] = job->scene;
+		job->scene = NULL;
+
+		if (world->scenes[job->chunk] != NULL) {
+			world->states[job->chunk] = ENG_CHUNK_UPLOADING;
+			world->uploads[world->uploadCount++] = job->chunk;
+		} else {
+			world->states[job->chunk] = ENG_CHUNK_LOADED;
+			world->stats.chunksLoaded++;
+		}
+		freeJob(job);
+	}
+}
+
+static void uploadChunks(eng_World *world) {
+	uint64_t start = SDL_GetTicksNS();
+	uint64_t deadline = start + world->uploadBudgetNS;
+
+	while (world->uploadCount > 0 && SDL_GetTicksNS() < deadline) {
+		uint32_t chunk = world->uploads[0];
+		bool done = false;
+		if (eng_uploadSceneAssets(world->window, world->scenes[chunk], deadline, &done) != SUCCESS) {
+			// Keeps whatever was created so a broken chunk isn't retried every frame
+			eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Failed to load chunk %u, %u\tError: %s", chunk % world->columns, chunk / world->columns, eng_getError());
+			done = true;
+		}
+
+		if (!done) {
+			break;
+		}
+
+		world->states[chunk] = ENG_CHUNK_LOADED;
+		world->stats.chunksLoaded++;
+		removeUpload(world, chunk);
+	}
+
+	world->stats.lastUploadMS = (float)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+	world->stats.peakUploadMS = SDL_max(world->stats.peakUploadMS, world->stats.lastUploadMS);
+}
+
+void eng_updateWorld(eng_World *world, float viewX, float viewY) {
+	if (world == NULL) {
+		return;
+	}
+
+	world->viewX = viewX;
+	world->viewY = viewY;
+
+	// Only the last kept range can hold chunks so huge worlds don't cost a walk over every chunk
+	ChunkRange keep = getChunkRange(world, world->loadRadius + 1);
+	for (int32_t row = world->kept.top; row <= world->kept.bottom; row++) {
+		for (int32_t column = world->kept.left; column <= world->kept.right; column++) {
+			uint32_t chunk = row * world->columns + column;
+			if (world->states[chunk] != ENG_CHUNK_UNLOADED && !inRange(keep, column, row)) {
+				unloadChunk(world, chunk);
+			}
+		}
+	}
+	world->kept = keep;
+
+	requestChunks(world, getChunkRange(world, world->loadRadius));
+	receiveChunks(world);
+	uploadChunks(world);
+}
+
+ENG_CHUNK_STATE eng_getChunkState(eng_World *world, uint32_t column, uint32_t row) {
+	if (world == NULL || column >= world->columns || row >= world->rows) {
+		return ENG_CHUNK_UNLOADED;
+	}
+
+	return world->states[row * world->columns + column];
+}
+
+void eng_getWorldStats(eng_World *world, eng_WorldStats *stats) {
+	*stats = world->stats;
+	stats->loaded = stats->loading = stats->uploading = 0;
+
+	for (int32_t row = world->kept.top; row <= world->kept.bottom; row++) {
+		for (int32_t column = world->kept.left; column <= world->kept.right; column++) {
+			switch (world->states[row * world->columns + column]) {
+				case ENG_CHUNK_LOADING:
+					stats->loading++;
+					break;
+				case ENG_CHUNK_UPLOADING:
+					stats->uploading++;
+					break;
+				case ENG_CHUNK_LOADED:
+					stats->loaded++;
+					break;
+			}
+		}
+	}
+}
+
+void eng_renderWorld(SDL_Renderer *renderer, eng_World *world) {
+	// One chunk of margin for objects that hang over the edge of their chunk
+	ChunkRange range = getChunkRange(world, 1);
+
+	for (int32_t row = range.top; row <= range.bottom; row++) {
+		for (int32_t column = range.left; column <= range.right; column++) {
+			uint32_t chunk = row * world->columns + column;
+			if (world->states[chunk] == ENG_CHUNK_LOADED && world->scenes[chunk] != NULL) {
+				eng_renderSceneOffset(renderer, world->scenes[chunk], -world->viewX, -world->viewY);
+			}
+		}
+	}
+}
+
+void eng_destroyWorld(eng_World *world) {
+	if (world == NULL) {
+		return;
+	}
+
+	if (world->loader != NULL) {
+		SDL_SetAtomicInt(&world->running, 0);
+		SDL_SignalSemaphore(world->wake);
+		SDL_WaitThread(world->loader, NULL);
+
+		uint32_t chunkCount = world->columns * world->rows;
+		eng_trackMemory(ENG_MEMORY_POOLS, -(int64_t)chunkCount * (sizeof(uint8_t) + sizeof(eng_Scene *) + sizeof(StreamJob *)
+			+ sizeof(uint32_t) + sizeof(ChunkRequest)), -1);
+	}
+
+	freeJobs(takeJobs(&world->pendingJobs));
+	freeJobs(takeJobs(&world->finishedJobs));
+
+	if (world->scenes != NULL) {
+		for (uint32_t chunk = 0; chunk < world->columns * world->rows; chunk++) {
+			eng_destroyScene(world->scenes[chunk]);
+		}
+	}
+
+	SDL_DestroySemaphore(world->wake);
+	SDL_free(world->pathFormat);
+	free(world->states);
+	free(world->scenes);
+	free(world->jobs);
+	free(world->uploads);
+	free(world->requests);
+	free(world);
+}
@@ -0,0 +1,75 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "engine.h"
+
+/*
+* Large levels split into a grid of chunks that are loaded around the camera and freed behind it.
+*
+* Every chunk is its own scene file written with eng_writeScene, its objects use world coordinates. A chunk without a file is empty.
+* eng_updateWorld asks a loading thread for the chunks within loadRadius of the view, nearest first, the thread maps the file, decodes
+* its images and renders its text. The main thread then only creates textures for a few milliseconds a frame, it never reads a file, so a
+* new chunk never costs a long frame.
+* Chunks are freed once they're more than loadRadius + 1 chunks from the view, the extra chunk stops a camera on a border from loading
+* and freeing the same chunk over and over. Only the chunks around the view are ever kept, which keeps the memory a world uses bounded
+* however big it is, textures chunks share are loaded once through the texture cache.
+*
+* Add the world to a render queue with TYPE_WORLD, it draws the loaded chunks moved by the view set with eng_updateWorld.
+*/
+
+#define ENG_WORLD_UPLOAD_MS 2.0f
+
+typedef enum {
+	ENG_CHUNK_UNLOADED,
+	ENG_CHUNK_LOADING, // Waiting for or being read by the loading thread
+	ENG_CHUNK_UPLOADING, // Decoded, its textures are being created
+	ENG_CHUNK_LOADED,
+} ENG_CHUNK_STATE;
+
+typedef struct {
+	uint32_t loaded;
+	uint32_t loading;
+	uint32_t uploading;
+
+	// Since the world was created
+	uint32_t chunksLoaded;
+	uint32_t chunksUnloaded;
+	uint32_t cancelled; // Left behind before they finished loading
+	float lastUploadMS;
+	float peakUploadMS;
+} eng_WorldStats;
+
+typedef struct eng_World eng_World;
+
+/*
+* Creates a world of columns by rows chunks of chunkSize pixels. pathFormat names the chunk files and has to contain two %u,
+* the column and then the row, for example "levels/forest/%u_%u.engs". Any other conversion fails with INVALID_CHUNK_PATH, write %% for a %
+*/
+eng_World *eng_createWorld(Window *window, const char *pathFormat, uint32_t columns, uint32_t rows, float chunkSize, uint32_t loadRadius);
+
+/*
+* Sets how long eng_updateWorld may spend creating textures each frame, ENG_WORLD_UPLOAD_MS by default
+*/
+void eng_setWorldUploadBudget(eng_World *world, float milliseconds);
+
+/*
+* Moves the view to viewX, viewY which is the world position of the top left of the window, then loads and frees chunks around it.
+* Call it once a frame before rendering
+*/
+void eng_updateWorld(eng_World *world, float viewX, float viewY);
+
+ENG_CHUNK_STATE eng_getChunkState(eng_World *world, uint32_t column, uint32_t row);
+
+void eng_getWorldStats(eng_World *world, eng_WorldStats *stats);
+
+/*
+* Draws the loaded chunks the view can see, this is called by the render queue for TYPE_WORLD
+*/
+void eng_renderWorld(SDL_Renderer *renderer, eng_World *world);
+
+/*
+* Stops the loading thread and frees every chunk
+*/
+void eng_destroyWorld(eng_World *world);
+
+#endif
@@ -5,6 +5,13 @@
 #include <stdlib.h>
 
 #include "engine.h"
+#include "hud.h"
+#include "transform.h"
+#include "present.h"
+#include "tween.h"
+#include "pick.h"
+#include "ui.h"
+#include "physics.h"
 
 typedef struct {
 	eng_Texture *texture;
@@ -14,30 +21,35 @@ typedef struct {
 typedef struct {
 	bool menuEnabled;
 	RenderQueue *queue;
+	eng_TransformTree *layout;
+	eng_Node root;
 	eng_Text *start;
 	eng_Text *options;
 	eng_Text *quit;
 } MainMenu;
 
+void addMenuItem(MainMenu *menu, eng_Text *text, float offset) {
+	eng_Node node = eng_createTransform(menu->layout, menu->root, -text->w / 2, -text->h / 2 + offset);
+	eng_bindTransform(menu->layout, node, text, TYPE_TEXT);
+}
+
 MainMenu createMainMenu(Window *window, const char *font, uint32_t fontSize) {
 	MainMenu menu = (MainMenu) {
 		.menuEnabled = true,
-		.queue = malloc(sizeof(RenderQueue)),
-		.start = malloc(sizeof(eng_Texture)),
-		.options = malloc(sizeof(eng_Texture)),
-		.quit = malloc(sizeof(eng_Texture)),
+		.queue = calloc(1, sizeof(RenderQueue)),
+		.layout = eng_createTransformTree(4),
 	};
 
 	menu.start = eng_createText(window, font, fontSize, "Start", (eng_Color){255, 255, 255, 255}, 0, 0),
 	menu.options = eng_createText(window, font, fontSize, "Options", (eng_Color){255, 255, 255, 255}, 0, 0),
 	menu.quit = eng_createText(window, font, fontSize, "Quit", (eng_Color){255, 255, 255, 255}, 0, 0),
 
-	eng_centerText(window, menu.start);
-	eng_centerText(window, menu.options);
-	eng_centerText(window, menu.quit);
-
-	menu.start->y -= fontSize;
-	menu.quit->y += fontSize;
+	// The items hang off a root node in the middle of the window so the whole menu moves together
+	menu.root = eng_createTransform(menu.layout, ENG_NO_NODE, window->width / 2.0f, window->height / 2.0f);
+	addMenuItem(&menu, menu.start, -(float)fontSize);
+	addMenuItem(&menu, menu.options, 0);
+	addMenuItem(&menu, menu.quit, fontSize);
+	eng_updateTransforms(menu.layout);
 
 	eng_addToCustomQueue(menu.queue, menu.start, TYPE_TEXT);
 	eng_addToCustomQueue(menu.queue, menu.options, TYPE_TEXT);
@@ -46,49 +58,171 @@ MainMenu createMainMenu(Window *window, const char *font, uint32_t fontSize) {
 	return menu;
 }
 
-int main() {
+// Drops the menu in from above the window
+void showMenu(MainMenu *menu, eng_Tweener *tweener, Window *window) {
+	menu->menuEnabled = true;
+	eng_setTransformPosition(menu->layout, menu->root, window->width / 2.0f, -window->height / 2.0f);
+	eng_tweenTransform(tweener, menu->layout, menu->root, ENG_AXIS_Y, window->height / 2.0f, 0.6f, ENG_EASE_OUT_BACK);
+}
+
+#define BENCH_BODIES 900
+#define BENCH_STEPS 600
+
+// Steps a world of bodies on tiles and platforms and prints the average and slowest step, run with --bench-physics
+int benchPhysics() {
+	eng_init(false);
+	eng_PhysicsWorld *world = eng_createPhysicsWorld(1500.0f, 64.0f, BENCH_BODIES);
+	eng_TileMap *map = eng_createTileMap(40, 20, 32.0f, 0, 0);
+	if (world == NULL || map == NULL) {
+		printf("%s\n", eng_getError());
+		return 1;
+	}
+
+	for (uint32_t column = 0; column < map->width; column++) {
+		eng_setTile(map, column, 15, ENG_TILE_SOLID);
+	}
+	for (uint32_t column = 0; column < 5; column++) {
+		eng_setTile(map, column, 8, ENG_TILE_ONE_WAY);
+	}
+	eng_setTile(map, 10, 14, ENG_TILE_SLOPE_UP);
+	eng_setTile(map, 11, 13, ENG_TILE_SLOPE_UP);
+	eng_setPhysicsTileMap(world, map);
+
+	// 800 bodies walking and falling between 100 one-way platforms
+	for (uint32_t i = 0; i < 800; i++) {
+		eng_Body body = eng_createBody(world, (i % 40) * 30.0f, (i / 40) * 20.0f, 16, 16, ENG_BODY_DYNAMIC);
+		eng_setBodyVelocity(world, body, ((int)(i % 7) - 3) * 60.0f, 0);
+	}
+	for (uint32_t i = 0; i < BENCH_BODIES - 800; i++) {
+		eng_createBody(world, (i % 20) * 64.0f, 100 + (i / 20) * 60.0f, 8, 48, ENG_BODY_SOLID | ENG_BODY_ONE_WAY);
+	}
+
+	double totalMS = 0;
+	double worstMS = 0;
+	for (uint32_t step = 0; step < BENCH_STEPS; step++) {
+		uint64_t start = SDL_GetTicksNS();
+		eng_stepPhysics(world, 1.0f / 60.0f);
+		double ms = (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+
+		totalMS += ms;
+		worstMS = SDL_max(worstMS, ms);
+	}
+
+	printf("Bodies:\t\t%d\n", BENCH_BODIES);
+	printf("Steps:\t\t%d\n", BENCH_STEPS);
+	printf("Average step:\t%.3f ms\n", totalMS / BENCH_STEPS);
+	printf("Slowest step:\t%.3f ms\n", worstMS);
+
+	eng_destroyPhysicsWorld(world);
+	eng_destroyTileMap(map);
+	eng_quit(NULL);
+
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	if (argc == 2 && strcmp(argv[1], "--bench-physics") == 0) {
+		return benchPhysics();
+	}
+
 	eng_init(true);
 	Application *appPtr = eng_createApplication("game", 800, 600);
 	if (appPtr == NULL) {
 		printf("%s\n", eng_getError());
 	}
 	Application app = *appPtr;
+	eng_setPixelArt(true);
 
 	Player player;
 	player.texture = eng_createImage(app.window, "../images/Items/Boxes/Box1/Idle.png", 28, 24, 0, 0);
 	eng_addObjectToRenderQueue(player.texture, TYPE_TEXTURE);
 
+	eng_Tweener *tweener = eng_createTweener(0);
+	eng_Tween bob = eng_tweenObject(tweener, player.texture, TYPE_TEXTURE, ENG_AXIS_Y, 16, 0.8f, ENG_EASE_IN_OUT_SINE);
+	eng_setTweenRepeat(tweener, bob, ENG_TWEEN_YOYO);
+
 	MainMenu menu = createMainMenu(app.window, "../fonts/Arial.ttf", 72);
+	showMenu(&menu, tweener, app.window);
+	bool virtualResolution = false;
+	uint64_t lastFrameNS = SDL_GetTicksNS();
+
+	// The menu is drawn over the game so it's on a higher layer
+	eng_PickIndex *picker = eng_createPickIndex();
+	eng_addPickQueue(picker, NULL, 0);
+	eng_addPickQueue(picker, menu.queue, 1);
+
+	// Options screen drawn over the menu with immediate mode widgets
+	eng_UI *ui = eng_createUI(app.window, "../images/Menu/Buttons");
+	eng_addToCustomQueue(menu.queue, ui, TYPE_UI);
+	bool optionsOpen = false;
+	float volume = 1.0f;
 
 	while (app.isRunning) {
 		while(eng_pollEvent(&app, 60)) {
+			eng_uiHandleEvent(ui, &app);
 			if (app.event.type == ENG_EVENT_KEY_DOWN) {
 				switch(app.event.value) {
 					case ENG_KEY_W:
 						printf("Forward\n");
 						break;
-					case ENG_KEY_G: ;
-						eng_Rect rect = {.h = 1, .w = 1, .x = app.mouse.x, .y = app.mouse.y};
-						if (eng_isTouchingRects(rect, eng_extractRectFromObject(menu.quit, TYPE_TEXT))) {
-							app.isRunning = false;
-						} else if (eng_isTouchingRects(rect, eng_extractRectFromObject(menu.options, TYPE_TEXT))) {
-							printf("Options\n");
-						} else if (eng_isTouchingRects(rect, eng_extractRectFromObject(menu.start, TYPE_TEXT))) {
-							menu.menuEnabled = false;
-						}
+					case ENG_KEY_H:
+						eng_setHudEnabled(!eng_isHudEnabled());
+						break;
+					case ENG_KEY_V:
+						virtualResolution = !virtualResolution;
+						eng_setVirtualResolution(app.window, 800, 600, virtualResolution ? ENG_SCALE_LETTERBOX : ENG_SCALE_DISABLED);
+						eng_setTransformPosition(menu.layout, menu.root, app.window->width / 2.0f, app.window->height / 2.0f);
 						break;
 					case ENG_KEY_ESC:
-						menu.menuEnabled = !menu.menuEnabled;
+						if (menu.menuEnabled) {
+							menu.menuEnabled = false;
+						} else {
+							showMenu(&menu, tweener, app.window);
+						}
+				}
+			} else if (app.event.type == ENG_MOUSE_BUTTON && app.event.value == MOUSE_BUTTON_LEFT && menu.menuEnabled && !optionsOpen) {
+				void *clicked = eng_pick(picker, app.mouse.x, app.mouse.y, NULL);
+				if (clicked == menu.quit) {
+					app.isRunning = false;
+				} else if (clicked == menu.options) {
+					optionsOpen = true;
+				} else if (clicked == menu.start) {
+					menu.menuEnabled = false;
 				}
+			} else if (app.event.type == ENG_EVENT_WINDOW_SIZE_CHANGED) {
+				eng_setTransformPosition(menu.layout, menu.root, app.window->width / 2.0f, app.window->height / 2.0f);
 			}
 		}
 
+		uint64_t now = SDL_GetTicksNS();
+		eng_updateTweens(tweener, (float)(now - lastFrameNS) / SDL_NS_PER_SECOND);
+		lastFrameNS = now;
+
 		if (menu.menuEnabled) {
+			eng_beginUI(ui);
+			if (optionsOpen) {
+				float left = app.window->width / 2.0f - 120;
+				float top = app.window->height / 2.0f - 60;
+				eng_uiPanel(ui, left, top, 120, 240, 0x101018F0);
+				eng_uiLabel(ui, "Volume", left + 16, top + 40, 0xFFFFFFFF);
+				eng_uiSlider(ui, &volume, 0, 1, left + 80, top + 36, 16, 140);
+				if (eng_uiIconButton(ui, ENG_UI_ICON_CLOSE, left + 240 - 40, top + 8, 2) || eng_uiButton(ui, "Back", left + 80, top + 80, 24, 80)) {
+					optionsOpen = false;
+				}
+			}
+			eng_endUI(ui);
+
+			eng_updateTransforms(menu.layout);
 			eng_renderCustomQueue(&app, menu.queue, (eng_Color){0,0,0,255});
 		} else {
 			eng_render(&app, (eng_Color){0,0,0,255});
 		}
 	}
 
+	eng_destroyPickIndex(picker);
+	eng_destroyTweener(tweener);
+	eng_destroyTransformTree(menu.layout);
+	eng_destroyCustomQueue(menu.queue);
+	free(menu.queue);
 	eng_quit(&app);
 }
\ No newline at end of file
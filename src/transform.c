@@ -0,0 +1,380 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "handle.h"
+#include "transform.h"
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+static bool reserveNodes(eng_TransformTree *tree, uint32_t capacity) {
+	if (capacity <= tree->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&tree->localX, capacity, sizeof(float))
+		|| !growArray((void **)&tree->localY, capacity, sizeof(float))
+		|| !growArray((void **)&tree->worldX, capacity, sizeof(float))
+		|| !growArray((void **)&tree->worldY, capacity, sizeof(float))
+		|| !growArray((void **)&tree->parent, capacity, sizeof(eng_Node))
+		|| !growArray((void **)&tree->dirty, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&tree->target, capacity, sizeof(eng_TransformTarget))
+		|| !growArray((void **)&tree->order, capacity, sizeof(eng_Node))
+		|| !growArray((void **)&tree->orderPosition, capacity, sizeof(uint32_t))) {
+		return false;
+	}
+	tree->capacity = capacity;
+
+	return true;
+}
+
+static bool isNode(eng_TransformTree *tree, eng_Node node) {
+	return tree != NULL && node < tree->count;
+}
+
+static void markDirty(eng_TransformTree *tree, eng_Node node) {
+	tree->dirty[node] = 1;
+	if (tree->orderPosition[node] < tree->firstDirty) {
+		tree->firstDirty = tree->orderPosition[node];
+	}
+}
+
+eng_TransformTree *eng_createTransformTree(uint32_t capacity) {
+	eng_TransformTree *tree = (eng_TransformTree *)calloc(1, sizeof(eng_TransformTree));
+	if (tree == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	if (!reserveNodes(tree, capacity == 0 ? 32 : capacity)) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroyTransformTree(tree);
+		return NULL;
+	}
+	tree->firstDirty = UINT32_MAX;
+
+	return tree;
+}
+
+eng_Node eng_createTransform(eng_TransformTree *tree, eng_Node parent, float x, float y) {
+	if (tree == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_NODE;
+	}
+
+	if (parent != ENG_NO_NODE && !isNode(tree, parent)) {
+		eng_setError(INVALID_TRANSFORM_PARENT);
+		return ENG_NO_NODE;
+	}
+
+	if (tree->count == tree->capacity && !reserveNodes(tree, tree->capacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_NO_NODE;
+	}
+
+	// The parent already exists so adding the node to the end keeps parents ahead of their children
+	eng_Node node = tree->count++;
+	tree->localX[node] = x;
+	tree->localY[node] = y;
+	tree->worldX[node] = x;
+	tree->worldY[node] = y;
+	tree->parent[node] = parent;
+	tree->target[node] = (eng_TransformTarget) {
+		.type = TYPE_UNKNOWN,
+	};
+	tree->order[node] = node;
+	tree->orderPosition[node] = node;
+	markDirty(tree, node);
+
+	return node;
+}
+
+void eng_setTransformPosition(eng_TransformTree *tree, eng_Node node, float x, float y) {
+	if (!isNode(tree, node)) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	tree->localX[node] = x;
+	tree->localY[node] = y;
+	markDirty(tree, node);
+}
+
+void eng_moveTransform(eng_TransformTree *tree, eng_Node node, float x, float y) {
+	if (!isNode(tree, node)) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	eng_setTransformPosition(tree, node, tree->localX[node] + x, tree->localY[node] + y);
+}
+
+ENG_RESULT eng_setTransformParent(eng_TransformTree *tree, eng_Node node, eng_Node parent) {
+	if (!isNode(tree, node)) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (parent != ENG_NO_NODE) {
+		if (!isNode(tree, parent)) {
+			return eng_setError(INVALID_TRANSFORM_PARENT);
+		}
+
+		for (eng_Node ancestor = parent; ancestor != ENG_NO_NODE; ancestor = tree->parent[ancestor]) {
+			if (ancestor == node) {
+				return eng_setError(INVALID_TRANSFORM_PARENT);
+			}
+		}
+	}
+
+	tree->parent[node] = parent;
+	tree->orderChanged = true;
+	markDirty(tree, node);
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_bindTransform(eng_TransformTree *tree, eng_Node node, void *object, Type type) {
+	if (!isNode(tree, node) || object == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	eng_Handle handle;
+	switch (type) {
+		case TYPE_RECT:
+			handle = ((eng_Rect *)object)->handle;
+			break;
+		case TYPE_TEXTURE:
+			handle = ((eng_Texture *)object)->handle;
+			break;
+		case TYPE_TEXT:
+			handle = ((eng_Text *)object)->handle;
+			break;
+		default:
+			return eng_setError(INVALID_TYPE);
+	}
+
+	tree->target[node] = (eng_TransformTarget) {
+		.type = type,
+		.handle = handle,
+	};
+	markDirty(tree, node);
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_bindTransformToBatch(eng_TransformTree *tree, eng_Node node, eng_RectBatch *batch, uint32_t index) {
+	if (!isNode(tree, node) || batch == NULL) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	if (index >= batch->count) {
+		return eng_setError(POSITION_HIGHER_THAN_QUEUE_LENGTH);
+	}
+
+	tree->target[node] = (eng_TransformTarget) {
+		.type = TYPE_RECT_BATCH,
+		.batch = batch,
+		.index = index,
+		.generation = batch->generation[index],
+	};
+	markDirty(tree, node);
+
+	return SUCCESS;
+}
+
+ENG_RESULT eng_unbindTransform(eng_TransformTree *tree, eng_Node node) {
+	if (!isNode(tree, node)) {
+		return eng_setError(DATA_IS_NULL);
+	}
+
+	tree->target[node] = (eng_TransformTarget) {
+		.type = TYPE_UNKNOWN,
+	};
+
+	return SUCCESS;
+}
+
+// Sorts the nodes by depth with a counting sort, only needed after a node changes parent
+static bool rebuildOrder(eng_TransformTree *tree) {
+	uint32_t count = tree->count;
+	uint32_t *depth = (uint32_t *)malloc(count * sizeof(uint32_t));
+	if (depth == NULL) {
+		return false;
+	}
+
+	uint32_t maxDepth = 0;
+	for (eng_Node node = 0; node < count; node++) {
+		depth[node] = 0;
+		for (eng_Node ancestor = tree->parent[node]; ancestor != ENG_NO_NODE; ancestor = tree->parent[ancestor]) {
+			depth[node]++;
+		}
+		maxDepth = SDL_max(maxDepth, depth[node]);
+	}
+
+	uint32_t *start = (uint32_t *)calloc(maxDepth + 2, sizeof(uint32_t));
+	if (start == NULL) {
+		free(depth);
+		return false;
+	}
+
+	for (eng_Node node = 0; node < count; node++) {
+		start[depth[node] + 1]++;
+	}
+	for (uint32_t i = 1; i <= maxDepth + 1; i++) {
+		start[i] += start[i - 1];
+	}
+	for (eng_Node node = 0; node < count; node++) {
+		uint32_t position = start[depth[node]]++;
+		tree->order[position] = node;
+		tree->orderPosition[node] = position;
+	}
+
+	free(start);
+	free(depth);
+
+	tree->firstDirty = UINT32_MAX;
+	for (eng_Node node = 0; node < count; node++) {
+		if (tree->dirty[node]) {
+			markDirty(tree, node);
+		}
+	}
+	tree->orderChanged = false;
+
+	return true;
+}
+
+static void writeTarget(eng_TransformTree *tree, eng_Node node) {
+	eng_TransformTarget *target = &tree->target[node];
+	float x = tree->worldX[node];
+	float y = tree->worldY[node];
+
+	switch (target->type) {
+		case TYPE_RECT:
+		case TYPE_TEXTURE:
+		case TYPE_TEXT:
+			if (!eng_isHandleValid(target->handle)) {
+				// The object was removed so there's nothing left to move
+				target->type = TYPE_UNKNOWN;
+				return;
+			}
+			break;
+		case TYPE_RECT_BATCH:
+			if (target->index >= target->batch->count || target->batch->generation[target->index] != target->generation) {
+				// The rect was removed, whatever is at its index now belongs to someone else
+				target->type = TYPE_UNKNOWN;
+				return;
+			}
+			target->batch->x[target->index] = x;
+			target->batch->y[target->index] = y;
+			return;
+		default:
+			return;
+	}
+
+	void *object = eng_getObject(target->handle, NULL);
+	float *objectX;
+	float *objectY;
+	if (target->type == TYPE_RECT) {
+		objectX = &((eng_Rect *)object)->x;
+		objectY = &((eng_Rect *)object)->y;
+	} else if (target->type == TYPE_TEXTURE) {
+		objectX = &((eng_Texture *)object)->x;
+		objectY = &((eng_Texture *)object)->y;
+	} else {
+		objectX = &((eng_Text *)object)->x;
+		objectY = &((eng_Text *)object)->y;
+	}
+
+	if (*objectX != x || *objectY != y) {
+		*objectX = x;
+		*objectY = y;
+		eng_markObjectMoved(target->handle);
+	}
+}
+
+void eng_updateTransforms(eng_TransformTree *tree) {
+	if (tree == NULL) {
+		return;
+	}
+
+	if (tree->orderChanged && !rebuildOrder(tree)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return;
+	}
+
+	if (tree->firstDirty >= tree->count) {
+		return;
+	}
+
+	for (uint32_t i = tree->firstDirty; i < tree->count; i++) {
+		eng_Node node = tree->order[i];
+		eng_Node parent = tree->parent[node];
+
+		if (parent == ENG_NO_NODE) {
+			if (!tree->dirty[node]) {
+				continue;
+			}
+			tree->worldX[node] = tree->localX[node];
+			tree->worldY[node] = tree->localY[node];
+		} else {
+			// A moved parent moves everything under it
+			tree->dirty[node] |= tree->dirty[parent];
+			if (!tree->dirty[node]) {
+				continue;
+			}
+			tree->worldX[node] = tree->worldX[parent] + tree->localX[node];
+			tree->worldY[node] = tree->worldY[parent] + tree->localY[node];
+		}
+
+		writeTarget(tree, node);
+	}
+
+	for (uint32_t i = tree->firstDirty; i < tree->count; i++) {
+		tree->dirty[tree->order[i]] = 0;
+	}
+	tree->firstDirty = UINT32_MAX;
+}
+
+void eng_getWorldPosition(eng_TransformTree *tree, eng_Node node, float *x, float *y) {
+	if (!isNode(tree, node)) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	eng_updateTransforms(tree);
+	if (x != NULL) {
+		*x = tree->worldX[node];
+	}
+	if (y != NULL) {
+		*y = tree->worldY[node];
+	}
+}
+
+void eng_destroyTransformTree(eng_TransformTree *tree) {
+	if (tree == NULL) {
+		return;
+	}
+
+	free(tree->localX);
+	free(tree->localY);
+	free(tree->worldX);
+	free(tree->worldY);
+	free(tree->parent);
+	free(tree->dirty);
+	free(tree->target);
+	free(tree->order);
+	free(tree->orderPosition);
+	free(tree);
+}
@@ -0,0 +1,95 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "engine.h"
+#include "batch.h"
+
+/*
+* Parent and child transforms so groups of objects like a menu or a character holding an item move together.
+*
+* Each node has a position relative to its parent and can be bound to an object, the object's x and y are overwritten with the node's world position.
+* Moving a node only marks it dirty, eng_updateTransforms recomputes the dirty nodes and their children in breadth-first order
+* starting from the first dirty node so parents are always finished before their children and unchanged parts of the tree are skipped.
+*
+* Nodes live as long as the tree, the arrays below can be read but positions should be changed through the functions so the dirty flags stay correct.
+*/
+
+typedef uint32_t eng_Node;
+
+#define ENG_NO_NODE UINT32_MAX
+
+typedef struct {
+	Type type;
+	eng_Handle handle;
+	eng_RectBatch *batch;
+	uint32_t index;
+	uint32_t generation;
+} eng_TransformTarget;
+
+typedef struct {
+	float *localX;
+	float *localY;
+	float *worldX;
+	float *worldY;
+	eng_Node *parent;
+	uint8_t *dirty;
+	eng_TransformTarget *target;
+	uint32_t count;
+	uint32_t capacity;
+
+	// Nodes sorted by depth, rebuilt when a node changes parent
+	eng_Node *order;
+	uint32_t *orderPosition;
+	uint32_t firstDirty;
+	bool orderChanged;
+} eng_TransformTree;
+
+eng_TransformTree *eng_createTransformTree(uint32_t capacity);
+
+/*
+* Adds a node at x and y relative to parent, pass ENG_NO_NODE for a root. Returns ENG_NO_NODE if it failed
+*/
+eng_Node eng_createTransform(eng_TransformTree *tree, eng_Node parent, float x, float y);
+
+/*
+* Moves a node relative to its parent, the node and everything under it is updated on the next eng_updateTransforms
+*/
+void eng_setTransformPosition(eng_TransformTree *tree, eng_Node node, float x, float y);
+
+void eng_moveTransform(eng_TransformTree *tree, eng_Node node, float x, float y);
+
+/*
+* Attaches the node to a new parent keeping its local position, a node can't be attached under itself
+*/
+ENG_RESULT eng_setTransformParent(eng_TransformTree *tree, eng_Node node, eng_Node parent);
+
+/*
+* Writes the node's world position into a rect, image or text every update, the object is found through its handle so it can be removed safely
+*/
+ENG_RESULT eng_bindTransform(eng_TransformTree *tree, eng_Node node, void *object, Type type);
+
+/*
+* Writes the node's world position into one rect of a batch every update. The binding is dropped once the rect is removed or the batch
+* is cleared, a rect moved into its index by eng_rectBatchRemove isn't moved by mistake. The batch has no handle so unbind the node
+* before destroying the batch
+*/
+ENG_RESULT eng_bindTransformToBatch(eng_TransformTree *tree, eng_Node node, eng_RectBatch *batch, uint32_t index);
+
+/*
+* Stops writing the node's world position into whatever it was bound to
+*/
+ENG_RESULT eng_unbindTransform(eng_TransformTree *tree, eng_Node node);
+
+/*
+* Recomputes world positions for every dirty node and its children and writes them into the bound objects, does nothing if nothing moved
+*/
+void eng_updateTransforms(eng_TransformTree *tree);
+
+/*
+* Updates the tree if needed and returns the node's world position
+*/
+void eng_getWorldPosition(eng_TransformTree *tree, eng_Node node, float *x, float *y);
+
+void eng_destroyTransformTree(eng_TransformTree *tree);
+
+#endif
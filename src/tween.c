@@ -0,0 +1,523 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "handle.h"
+#include "tween.h"
+
+#define NO_TWEEN_SLOT UINT32_MAX
+#define MIN_DURATION 0.0001f
+
+// Values of eng_Tweener.started
+#define TWEEN_WAITING 0
+#define TWEEN_STARTING 1
+#define TWEEN_RUNNING 2
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+// Bytes taken by one tween across every array, for memory accounting
+#define TWEEN_BYTES (7 * sizeof(float) + 3 * sizeof(uint8_t) + sizeof(eng_TweenTarget) + 3 * sizeof(uint32_t))
+
+static bool reserveTweens(eng_Tweener *tweener, uint32_t capacity) {
+	if (capacity <= tweener->capacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&tweener->time, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->duration, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->inverseDuration, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->from, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->to, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->progress, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->value, capacity, sizeof(float))
+		|| !growArray((void **)&tweener->ease, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&tweener->repeat, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&tweener->started, capacity, sizeof(uint8_t))
+		|| !growArray((void **)&tweener->target, capacity, sizeof(eng_TweenTarget))
+		|| !growArray((void **)&tweener->slot, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&tweener->index, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&tweener->generation, capacity, sizeof(uint32_t))) {
+		return false;
+	}
+	eng_trackMemory(ENG_MEMORY_POOLS, (int64_t)(capacity - tweener->capacity) * TWEEN_BYTES, tweener->capacity == 0 ? 1 : 0);
+	tweener->capacity = capacity;
+
+	return true;
+}
+
+// Returns the tween's position in the active list or NO_TWEEN_SLOT if it finished or was stopped
+static uint32_t findTween(eng_Tweener *tweener, eng_Tween tween) {
+	uint32_t slot = tween & ENG_HANDLE_INDEX_MASK;
+	if (tweener == NULL || tween == ENG_NO_TWEEN || slot >= tweener->slotCount || tweener->generation[slot] != tween >> ENG_HANDLE_INDEX_BITS) {
+		return NO_TWEEN_SLOT;
+	}
+
+	return tweener->index[slot];
+}
+
+static void removeTween(eng_Tweener *tweener, uint32_t i) {
+	uint32_t slot = tweener->slot[i];
+	tweener->generation[slot] = (tweener->generation[slot] + 1) & ENG_HANDLE_GENERATION_MASK;
+	if (tweener->generation[slot] == 0) {
+		tweener->generation[slot] = 1;
+	}
+	tweener->index[slot] = tweener->freeSlot;
+	tweener->freeSlot = slot;
+
+	// The last tween fills the gap so the active list stays packed
+	uint32_t last = --tweener->count;
+	if (i != last) {
+		tweener->time[i] = tweener->time[last];
+		tweener->duration[i] = tweener->duration[last];
+		tweener->inverseDuration[i] = tweener->inverseDuration[last];
+		tweener->from[i] = tweener->from[last];
+		tweener->to[i] = tweener->to[last];
+		tweener->progress[i] = tweener->progress[last];
+		tweener->value[i] = tweener->value[last];
+		tweener->ease[i] = tweener->ease[last];
+		tweener->repeat[i] = tweener->repeat[last];
+		tweener->started[i] = tweener->started[last];
+		tweener->target[i] = tweener->target[last];
+		tweener->slot[i] = tweener->slot[last];
+		tweener->index[tweener->slot[i]] = i;
+	}
+}
+
+static eng_Tween addTween(eng_Tweener *tweener, eng_TweenTarget target, float to, float duration, ENG_EASE ease) {
+	if (tweener->count == tweener->capacity && !reserveTweens(tweener, tweener->capacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return ENG_NO_TWEEN;
+	}
+
+	uint32_t slot = tweener->freeSlot;
+	if (slot != NO_TWEEN_SLOT) {
+		tweener->freeSlot = tweener->index[slot];
+	} else {
+		if (tweener->slotCount == ENG_MAX_HANDLES) {
+			eng_setError(OUT_OF_HANDLES);
+			return ENG_NO_TWEEN;
+		}
+		slot = tweener->slotCount++;
+		tweener->generation[slot] = 1;
+	}
+
+	uint32_t i = tweener->count++;
+	duration = SDL_max(duration, MIN_DURATION);
+	tweener->time[i] = 0;
+	tweener->duration[i] = duration;
+	tweener->inverseDuration[i] = 1.0f / duration;
+	tweener->from[i] = 0;
+	tweener->to[i] = to;
+	tweener->progress[i] = 0;
+	tweener->value[i] = 0;
+	tweener->ease[i] = ease;
+	tweener->repeat[i] = ENG_TWEEN_ONCE;
+	tweener->started[i] = TWEEN_WAITING;
+	tweener->target[i] = target;
+	tweener->slot[i] = slot;
+	tweener->index[slot] = i;
+
+	return (tweener->generation[slot] << ENG_HANDLE_INDEX_BITS) | slot;
+}
+
+static float *getObjectField(eng_Handle handle, ENG_AXIS axis) {
+	Type type;
+	void *object = eng_getObject(handle, &type);
+	if (object == NULL) {
+		return NULL;
+	}
+
+	switch (type) {
+		case TYPE_RECT:
+			return axis == ENG_AXIS_X ? &((eng_Rect *)object)->x : &((eng_Rect *)object)->y;
+		case TYPE_TEXTURE:
+			return axis == ENG_AXIS_X ? &((eng_Texture *)object)->x : &((eng_Texture *)object)->y;
+		case TYPE_TEXT:
+			return axis == ENG_AXIS_X ? &((eng_Text *)object)->x : &((eng_Text *)object)->y;
+		default:
+			return NULL;
+	}
+}
+
+// Returns false once the target is gone so the tween can be dropped
+static bool readTarget(eng_TweenTarget *target, float *value) {
+	float *field;
+	switch (target->type) {
+		case ENG_TWEEN_FIELD:
+			*value = *target->field;
+			return true;
+		case ENG_TWEEN_OBJECT:
+			if (!eng_isHandleValid(target->handle)) {
+				return false;
+			}
+			field = getObjectField(target->handle, target->axis);
+			if (field == NULL) {
+				return false;
+			}
+			*value = *field;
+			return true;
+		case ENG_TWEEN_TRANSFORM:
+			if (target->node >= target->tree->count) {
+				return false;
+			}
+			*value = target->axis == ENG_AXIS_X ? target->tree->localX[target->node] : target->tree->localY[target->node];
+			return true;
+	}
+
+	return false;
+}
+
+static bool writeTarget(eng_TweenTarget *target, float value) {
+	float *field;
+	eng_TransformTree *tree = target->tree;
+	switch (target->type) {
+		case ENG_TWEEN_FIELD:
+			*target->field = value;
+			return true;
+		case ENG_TWEEN_OBJECT:
+			if (!eng_isHandleValid(target->handle)) {
+				return false;
+			}
+			field = getObjectField(target->handle, target->axis);
+			if (field == NULL) {
+				return false;
+			}
+			if (*field != value) {
+				*field = value;
+				eng_markObjectMoved(target->handle);
+			}
+			return true;
+		case ENG_TWEEN_TRANSFORM:
+			if (target->node >= tree->count) {
+				return false;
+			}
+			if (target->axis == ENG_AXIS_X) {
+				eng_setTransformPosition(tree, target->node, value, tree->localY[target->node]);
+			} else {
+				eng_setTransformPosition(tree, target->node, tree->localX[target->node], value);
+			}
+			return true;
+	}
+
+	return false;
+}
+
+eng_Tweener *eng_createTweener(uint32_t capacity) {
+	eng_Tweener *tweener = (eng_Tweener *)calloc(1, sizeof(eng_Tweener));
+	if (tweener == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+
+	if (!reserveTweens(tweener, capacity == 0 ? 64 : capacity)) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroyTweener(tweener);
+		return NULL;
+	}
+	tweener->freeSlot = NO_TWEEN_SLOT;
+
+	return tweener;
+}
+
+eng_Tween eng_tween(eng_Tweener *tweener, float *field, float to, float duration, ENG_EASE ease) {
+	if (tweener == NULL || field == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_TWEEN;
+	}
+
+	return addTween(tweener, (eng_TweenTarget) {
+		.type = ENG_TWEEN_FIELD,
+		.field = field,
+	}, to, duration, ease);
+}
+
+eng_Tween eng_tweenObject(eng_Tweener *tweener, void *object, Type type, ENG_AXIS axis, float to, float duration, ENG_EASE ease) {
+	if (tweener == NULL || object == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_TWEEN;
+	}
+
+	eng_Handle handle;
+	switch (type) {
+		case TYPE_RECT:
+			handle = ((eng_Rect *)object)->handle;
+			break;
+		case TYPE_TEXTURE:
+			handle = ((eng_Texture *)object)->handle;
+			break;
+		case TYPE_TEXT:
+			handle = ((eng_Text *)object)->handle;
+			break;
+		default:
+			eng_setError(INVALID_TYPE);
+			return ENG_NO_TWEEN;
+	}
+
+	return addTween(tweener, (eng_TweenTarget) {
+		.type = ENG_TWEEN_OBJECT,
+		.axis = axis,
+		.handle = handle,
+	}, to, duration, ease);
+}
+
+eng_Tween eng_tweenTransform(eng_Tweener *tweener, eng_TransformTree *tree, eng_Node node, ENG_AXIS axis, float to, float duration, ENG_EASE ease) {
+	if (tweener == NULL || tree == NULL || node >= tree->count) {
+		eng_setError(DATA_IS_NULL);
+		return ENG_NO_TWEEN;
+	}
+
+	return addTween(tweener, (eng_TweenTarget) {
+		.type = ENG_TWEEN_TRANSFORM,
+		.axis = axis,
+		.tree = tree,
+		.node = node,
+	}, to, duration, ease);
+}
+
+void eng_setTweenDelay(eng_Tweener *tweener, eng_Tween tween, float delay) {
+	uint32_t i = findTween(tweener, tween);
+	if (i == NO_TWEEN_SLOT) {
+		eng_setError(STALE_HANDLE);
+		return;
+	}
+
+	tweener->time[i] = -SDL_max(delay, 0.0f);
+}
+
+void eng_setTweenRepeat(eng_Tweener *tweener, eng_Tween tween, ENG_TWEEN_REPEAT repeat) {
+	uint32_t i = findTween(tweener, tween);
+	if (i == NO_TWEEN_SLOT) {
+		eng_setError(STALE_HANDLE);
+		return;
+	}
+
+	tweener->repeat[i] = repeat;
+}
+
+void eng_setTweenFrom(eng_Tweener *tweener, eng_Tween tween, float from) {
+	uint32_t i = findTween(tweener, tween);
+	if (i == NO_TWEEN_SLOT) {
+		eng_setError(STALE_HANDLE);
+		return;
+	}
+
+	tweener->from[i] = from;
+	tweener->started[i] = TWEEN_RUNNING;
+}
+
+void eng_stopTween(eng_Tweener *tweener, eng_Tween tween) {
+	uint32_t i = findTween(tweener, tween);
+	if (i != NO_TWEEN_SLOT) {
+		removeTween(tweener, i);
+	}
+}
+
+bool eng_isTweenActive(eng_Tweener *tweener, eng_Tween tween) {
+	return findTween(tweener, tween) != NO_TWEEN_SLOT;
+}
+
+float eng_ease(ENG_EASE ease, float t) {
+	t = SDL_clamp(t, 0.0f, 1.0f);
+	float inverse = 1.0f - t;
+
+	switch (ease) {
+		case ENG_EASE_IN_QUAD:
+			return t * t;
+		case ENG_EASE_OUT_QUAD:
+			return 1.0f - inverse * inverse;
+		case ENG_EASE_IN_OUT_QUAD:
+			return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * inverse * inverse;
+		case ENG_EASE_IN_CUBIC:
+			return t * t * t;
+		case ENG_EASE_OUT_CUBIC:
+			return 1.0f - inverse * inverse * inverse;
+		case ENG_EASE_IN_OUT_CUBIC:
+			return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * inverse * inverse * inverse;
+		case ENG_EASE_IN_SINE:
+			return 1.0f - SDL_cosf(t * SDL_PI_F / 2.0f);
+		case ENG_EASE_OUT_SINE:
+			return SDL_sinf(t * SDL_PI_F / 2.0f);
+		case ENG_EASE_IN_OUT_SINE:
+			return (1.0f - SDL_cosf(t * SDL_PI_F)) / 2.0f;
+		case ENG_EASE_OUT_BACK:
+			// Overshoots the target by about 10% then settles back
+			return 1.0f + 2.70158f * (t - 1.0f) * (t - 1.0f) * (t - 1.0f) + 1.70158f * (t - 1.0f) * (t - 1.0f);
+		case ENG_EASE_OUT_BOUNCE:
+			if (t < 1.0f / 2.75f) {
+				return 7.5625f * t * t;
+			} else if (t < 2.0f / 2.75f) {
+				t -= 1.5f / 2.75f;
+				return 7.5625f * t * t + 0.75f;
+			} else if (t < 2.5f / 2.75f) {
+				t -= 2.25f / 2.75f;
+				return 7.5625f * t * t + 0.9375f;
+			}
+			t -= 2.625f / 2.75f;
+			return 7.5625f * t * t + 0.984375f;
+		default:
+			return t;
+	}
+}
+
+void eng_updateTweens(eng_Tweener *tweener, float deltaSeconds) {
+	if (tweener == NULL || tweener->count == 0) {
+		return;
+	}
+
+	uint32_t count = tweener->count;
+	float *restrict time = tweener->time;
+	float *restrict inverseDuration = tweener->inverseDuration;
+	float *restrict progress = tweener->progress;
+	float *restrict from = tweener->from;
+	float *restrict to = tweener->to;
+	float *restrict value = tweener->value;
+
+	for (uint32_t i = 0; i < count; i++) {
+		time[i] += deltaSeconds;
+		progress[i] = SDL_clamp(time[i] * inverseDuration[i], 0.0f, 1.0f);
+	}
+
+	// Every tween can have its own curve so this loop branches, keeping it apart leaves the loops around it branch free
+	for (uint32_t i = 0; i < count; i++) {
+		value[i] = tweener->ease[i] == ENG_EASE_LINEAR ? progress[i] : eng_ease(tweener->ease[i], progress[i]);
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		value[i] = from[i] + (to[i] - from[i]) * value[i];
+	}
+
+	// Walks backwards so the tween swapped into a removed tween's place was already updated
+	for (uint32_t i = count; i-- > 0;) {
+		if (time[i] < 0) {
+			continue;
+		}
+
+		if (tweener->started[i] != TWEEN_RUNNING) {
+			tweener->started[i] = TWEEN_STARTING;
+			continue;
+		}
+
+		if (!writeTarget(&tweener->target[i], value[i])) {
+			removeTween(tweener, i);
+			continue;
+		}
+
+		if (progress[i] < 1.0f) {
+			continue;
+		}
+
+		switch (tweener->repeat[i]) {
+			case ENG_TWEEN_YOYO: {
+				float start = from[i];
+				from[i] = to[i];
+				to[i] = start;
+			}
+			// fall through
+			case ENG_TWEEN_LOOP:
+				time[i] = SDL_min(time[i] - tweener->duration[i], tweener->duration[i]);
+				break;
+			default:
+				removeTween(tweener, i);
+				break;
+		}
+	}
+
+	// Tweens starting this frame read their start value after the others were written, so a tween queued
+	// on a timeline continues from exactly where the previous one on the same target stopped
+	for (uint32_t i = tweener->count; i-- > 0;) {
+		if (tweener->started[i] != TWEEN_STARTING) {
+			continue;
+		}
+
+		if (!readTarget(&tweener->target[i], &from[i])) {
+			removeTween(tweener, i);
+			continue;
+		}
+		tweener->started[i] = TWEEN_RUNNING;
+		writeTarget(&tweener->target[i], from[i] + (to[i] - from[i]) * eng_ease(tweener->ease[i], progress[i]));
+	}
+}
+
+void eng_clearTweens(eng_Tweener *tweener) {
+	if (tweener == NULL) {
+		return;
+	}
+
+	while (tweener->count > 0) {
+		removeTween(tweener, tweener->count - 1);
+	}
+}
+
+void eng_destroyTweener(eng_Tweener *tweener) {
+	if (tweener == NULL) {
+		return;
+	}
+
+	if (tweener->capacity > 0) {
+		eng_trackMemory(ENG_MEMORY_POOLS, -(int64_t)(tweener->capacity * TWEEN_BYTES), -1);
+	}
+	free(tweener->time);
+	free(tweener->duration);
+	free(tweener->inverseDuration);
+	free(tweener->from);
+	free(tweener->to);
+	free(tweener->progress);
+	free(tweener->value);
+	free(tweener->ease);
+	free(tweener->repeat);
+	free(tweener->started);
+	free(tweener->target);
+	free(tweener->slot);
+	free(tweener->index);
+	free(tweener->generation);
+	free(tweener);
+}
+
+eng_Timeline eng_beginTimeline(eng_Tweener *tweener, float delay) {
+	return (eng_Timeline) {
+		.tweener = tweener,
+		.start = SDL_max(delay, 0.0f),
+		.end = SDL_max(delay, 0.0f),
+	};
+}
+
+void eng_timelineThen(eng_Timeline *timeline, eng_Tween tween) {
+	uint32_t i = timeline == NULL ? NO_TWEEN_SLOT : findTween(timeline->tweener, tween);
+	if (i == NO_TWEEN_SLOT) {
+		eng_setError(STALE_HANDLE);
+		return;
+	}
+
+	timeline->start = timeline->end;
+	timeline->end += timeline->tweener->duration[i];
+	timeline->tweener->time[i] = -timeline->start;
+}
+
+void eng_timelineWith(eng_Timeline *timeline, eng_Tween tween) {
+	uint32_t i = timeline == NULL ? NO_TWEEN_SLOT : findTween(timeline->tweener, tween);
+	if (i == NO_TWEEN_SLOT) {
+		eng_setError(STALE_HANDLE);
+		return;
+	}
+
+	timeline->end = SDL_max(timeline->end, timeline->start + timeline->tweener->duration[i]);
+	timeline->tweener->time[i] = -timeline->start;
+}
+
+void eng_timelineWait(eng_Timeline *timeline, float seconds) {
+	if (timeline != NULL) {
+		timeline->end += SDL_max(seconds, 0.0f);
+	}
+}
@@ -0,0 +1,170 @@
+#ifndef TWEEN_H
+#define TWEEN_H
+
+#include "engine.h"
+#include "transform.h"
+
+/*
+* Tweens move a float from its current value to a target value over time with an easing curve, for menus sliding in, fades and camera moves.
+*
+* Active tweens are packed at the front of the arrays below and eng_updateTweens advances all of them in a few tight loops, the time and
+* interpolation loops have no branches so the compiler can vectorize them. Easing sits in its own loop between them and picks each tween's
+* curve with a switch, so it isn't vectorized. A finished tween is swapped with the last active one and its
+* slot goes back on a free list, so starting tweens after the arrays have grown never allocates.
+*
+* A tween can drive a plain float, the x or y of a rect, image or text through its handle, or a transform node. Tweens on a plain float
+* must be stopped before the float is freed, object and transform tweens stop by themselves when the object is removed.
+*/
+
+typedef uint32_t eng_Tween;
+
+#define ENG_NO_TWEEN 0
+
+typedef enum {
+	ENG_EASE_LINEAR,
+	ENG_EASE_IN_QUAD,
+	ENG_EASE_OUT_QUAD,
+	ENG_EASE_IN_OUT_QUAD,
+	ENG_EASE_IN_CUBIC,
+	ENG_EASE_OUT_CUBIC,
+	ENG_EASE_IN_OUT_CUBIC,
+	ENG_EASE_IN_SINE,
+	ENG_EASE_OUT_SINE,
+	ENG_EASE_IN_OUT_SINE,
+	ENG_EASE_OUT_BACK,
+	ENG_EASE_OUT_BOUNCE,
+} ENG_EASE;
+
+typedef enum {
+	ENG_TWEEN_ONCE,
+	ENG_TWEEN_LOOP, // Jumps back to the start value
+	ENG_TWEEN_YOYO, // Plays forwards then backwards forever
+} ENG_TWEEN_REPEAT;
+
+typedef enum {
+	ENG_AXIS_X,
+	ENG_AXIS_Y,
+} ENG_AXIS;
+
+typedef enum {
+	ENG_TWEEN_FIELD,
+	ENG_TWEEN_OBJECT,
+	ENG_TWEEN_TRANSFORM,
+} ENG_TWEEN_TARGET;
+
+typedef struct {
+	ENG_TWEEN_TARGET type;
+	ENG_AXIS axis;
+	float *field;
+	eng_Handle handle;
+	eng_TransformTree *tree;
+	eng_Node node;
+} eng_TweenTarget;
+
+typedef struct {
+	// Indexed by position in the active list
+	float *time; // Seconds since the tween started, negative while it's delayed
+	float *duration;
+	float *inverseDuration;
+	float *from;
+	float *to;
+	float *progress;
+	float *value;
+	uint8_t *ease;
+	uint8_t *repeat;
+	uint8_t *started;
+	eng_TweenTarget *target;
+	uint32_t *slot;
+	uint32_t count;
+	uint32_t capacity;
+
+	// Indexed by the tween's slot, a free slot's index is the next free slot
+	uint32_t *index;
+	uint32_t *generation;
+	uint32_t freeSlot;
+	uint32_t slotCount;
+} eng_Tweener;
+
+/*
+* A timeline places tweens one after another or side by side by setting their delays, see eng_timelineThen
+*/
+typedef struct {
+	eng_Tweener *tweener;
+	float start; // When the last step started
+	float end; // When everything added so far has finished
+} eng_Timeline;
+
+eng_Tweener *eng_createTweener(uint32_t capacity);
+
+/*
+* Moves field to the value to over duration seconds, the start value is read when the tween starts. Returns ENG_NO_TWEEN if it failed
+*/
+eng_Tween eng_tween(eng_Tweener *tweener, float *field, float to, float duration, ENG_EASE ease);
+
+/*
+* Moves the x or y of a rect, image or text, the tween stops if the object is removed
+*/
+eng_Tween eng_tweenObject(eng_Tweener *tweener, void *object, Type type, ENG_AXIS axis, float to, float duration, ENG_EASE ease);
+
+/*
+* Moves a transform node relative to its parent so everything under it moves too
+*/
+eng_Tween eng_tweenTransform(eng_Tweener *tweener, eng_TransformTree *tree, eng_Node node, ENG_AXIS axis, float to, float duration, ENG_EASE ease);
+
+/*
+* Waits this many seconds before the tween starts
+*/
+void eng_setTweenDelay(eng_Tweener *tweener, eng_Tween tween, float delay);
+
+void eng_setTweenRepeat(eng_Tweener *tweener, eng_Tween tween, ENG_TWEEN_REPEAT repeat);
+
+/*
+* Starts from this value instead of the target's value when the tween starts
+*/
+void eng_setTweenFrom(eng_Tweener *tweener, eng_Tween tween, float from);
+
+/*
+* Stops the tween where it is, the target keeps its current value
+*/
+void eng_stopTween(eng_Tweener *tweener, eng_Tween tween);
+
+/*
+* Returns weather the tween is still delayed or running, a finished tween isn't active
+*/
+bool eng_isTweenActive(eng_Tweener *tweener, eng_Tween tween);
+
+/*
+* Advances every tween by deltaSeconds and writes the new values into their targets
+*/
+void eng_updateTweens(eng_Tweener *tweener, float deltaSeconds);
+
+void eng_clearTweens(eng_Tweener *tweener);
+
+void eng_destroyTweener(eng_Tweener *tweener);
+
+/*
+* Returns the easing curve at t, t is clamped between 0 and 1
+*/
+float eng_ease(ENG_EASE ease, float t);
+
+/*
+* Starts a timeline delay seconds from now
+*/
+eng_Timeline eng_beginTimeline(eng_Tweener *tweener, float delay);
+
+/*
+* Starts the tween once everything added before it has finished
+*/
+void eng_timelineThen(eng_Timeline *timeline, eng_Tween tween);
+
+/*
+* Starts the tween at the same time as the last tween added with eng_timelineThen
+*/
+void eng_timelineWith(eng_Timeline *timeline, eng_Tween tween);
+
+/*
+* Leaves a gap before the next tween added with eng_timelineThen
+*/
+void eng_timelineWait(eng_Timeline *timeline, float seconds);
+
+#endif
@@ -0,0 +1,602 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "engine.h"
+#include "internal.h"
+#include "log.h"
+#include "ui.h"
+
+#define UI_NO_WIDGET UINT32_MAX
+
+#define UI_BUTTON_COLOR 0x3A3A50E0
+#define UI_HOVER_COLOR 0x50506EE0
+#define UI_PRESSED_COLOR 0x2A2A3CE0
+#define UI_TEXT_COLOR 0xFFFFFFFF
+#define UI_TRACK_COLOR 0x202030E0
+#define UI_FILL_COLOR 0x5A8CDCFF
+#define UI_KNOB_COLOR 0xE0E0F0FF
+#define UI_LIST_COLOR 0x202030E0
+#define UI_SELECTED_COLOR 0x5A8CDCE0
+#define UI_ICON_HOVER_TINT 0xD0D0FFFF
+#define UI_ICON_PRESSED_TINT 0x9090A0FF
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+static const char *iconFiles[ENG_UI_ICON_COUNT] = {
+	"Achievements.png",
+	"Back.png",
+	"Close.png",
+	"Leaderboard.png",
+	"Levels.png",
+	"Next.png",
+	"Play.png",
+	"Previous.png",
+	"Restart.png",
+	"Settings.png",
+	"Volume.png",
+};
+
+static bool growArray(void **array, uint32_t capacity, size_t elementSize) {
+	void *newArray = realloc(*array, capacity * elementSize);
+	if (newArray == NULL) {
+		return false;
+	}
+	*array = newArray;
+
+	return true;
+}
+
+static bool reserveQuads(eng_UI *ui, uint32_t capacity) {
+	if (capacity <= ui->quadCapacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&ui->x, capacity, sizeof(float))
+		|| !growArray((void **)&ui->y, capacity, sizeof(float))
+		|| !growArray((void **)&ui->h, capacity, sizeof(float))
+		|| !growArray((void **)&ui->w, capacity, sizeof(float))
+		|| !growArray((void **)&ui->color, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&ui->icon, capacity, sizeof(uint8_t))) {
+		return false;
+	}
+	ui->quadCapacity = capacity;
+
+	return true;
+}
+
+static bool reserveLabels(eng_UI *ui, uint32_t capacity) {
+	if (capacity <= ui->labelCapacity) {
+		return true;
+	}
+
+	if (!growArray((void **)&ui->labelX, capacity, sizeof(float))
+		|| !growArray((void **)&ui->labelY, capacity, sizeof(float))
+		|| !growArray((void **)&ui->labelColor, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&ui->textStart, capacity, sizeof(uint32_t))
+		|| !growArray((void **)&ui->labelQuad, capacity, sizeof(uint32_t))) {
+		return false;
+	}
+	ui->labelCapacity = capacity;
+
+	return true;
+}
+
+// Same as the batches, the index pattern is only written when the vertices grow past it
+static bool reserveVertices(eng_UI *ui, uint32_t count) {
+	if (count <= ui->vertexCapacity) {
+		return true;
+	}
+
+	// Every quad can start its own range at worst
+	if (!growArray((void **)&ui->vertices, count * 8, sizeof(float))
+		|| !growArray((void **)&ui->uvs, count * 8, sizeof(float))
+		|| !growArray((void **)&ui->vertexColors, count * 4, sizeof(SDL_FColor))
+		|| !growArray((void **)&ui->indices, count * 6, sizeof(int))
+		|| !growArray((void **)&ui->rangeStart, count, sizeof(uint32_t))
+		|| !growArray((void **)&ui->rangeCount, count, sizeof(uint32_t))
+		|| !growArray((void **)&ui->rangeIcon, count, sizeof(uint8_t))) {
+		return false;
+	}
+
+	eng_fillQuadIndices(ui->indices, ui->vertexCapacity, count);
+	ui->vertexCapacity = count;
+
+	return true;
+}
+
+eng_UI *eng_createUI(Window *window, const char *buttonDirectory) {
+	if (window == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return NULL;
+	}
+
+	eng_UI *ui = (eng_UI *)calloc(1, sizeof(eng_UI));
+	if (ui == NULL) {
+		eng_setError(FAILED_TO_MALLOC);
+		return NULL;
+	}
+	ui->active = UI_NO_WIDGET;
+
+	if (!reserveQuads(ui, 64) || !reserveLabels(ui, 32) || !growArray((void **)&ui->text, 512, sizeof(char))) {
+		eng_setError(FAILED_TO_MALLOC);
+		eng_destroyUI(ui);
+		return NULL;
+	}
+	ui->textCapacity = 512;
+
+	if (buttonDirectory == NULL) {
+		return ui;
+	}
+
+	// A missing image only disables its icon buttons, text widgets still work
+	char path[512];
+	for (uint32_t i = 0; i < ENG_UI_ICON_COUNT; i++) {
+		if (!eng_joinPath(path, sizeof(path), buttonDirectory, iconFiles[i])) {
+			continue;
+		}
+
+		// Without a renderer only the icon's size is read so the buttons still take up space and report clicks
+		int w, h;
+		if (window->pRenderer == NULL) {
+			if (!eng_loadImageSize(path, &w, &h)) {
+				eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Failed to load UI button %s", path);
+				continue;
+			}
+		} else {
+			ui->icons[i] = eng_loadTexture(window->pRenderer, path);
+			if (ui->icons[i] == NULL) {
+				eng_log(ENG_LOG_WARN, ENG_LOG_ASSET, "Failed to load UI button %s", path);
+				continue;
+			}
+			w = ui->icons[i]->w;
+			h = ui->icons[i]->h;
+		}
+		ui->iconH[i] = (float)h;
+		ui->iconW[i] = (float)w;
+	}
+
+	return ui;
+}
+
+void eng_uiHandleEvent(eng_UI *ui, Application *app) {
+	if (ui == NULL || app == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	switch (app->event.type) {
+		case ENG_MOUSE_BUTTON:
+			if (app->event.value == MOUSE_BUTTON_LEFT) {
+				ui->pendingPress = true;
+				ui->mouseDown = true;
+				ui->pressX = app->mouse.x;
+				ui->pressY = app->mouse.y;
+			}
+			break;
+		case ENG_MOUSE_BUTTON_UP:
+			if (app->event.value == MOUSE_BUTTON_LEFT) {
+				ui->pendingRelease = true;
+				ui->mouseDown = false;
+			}
+			break;
+		case ENG_EVENT_MOUSE_MOTION:
+			break;
+		default:
+			return;
+	}
+
+	ui->mouseX = app->mouse.x;
+	ui->mouseY = app->mouse.y;
+}
+
+void eng_beginUI(eng_UI *ui) {
+	if (ui == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	// A press and release in the same frame still counts as a click
+	ui->mousePressed = ui->pendingPress;
+	ui->mouseReleased = ui->pendingRelease;
+	ui->pendingPress = false;
+	ui->pendingRelease = false;
+
+	ui->widget = 0;
+	ui->quadCount = 0;
+	ui->labelCount = 0;
+	ui->textLength = 0;
+}
+
+static void addQuad(eng_UI *ui, float x, float y, float h, float w, uint32_t color, uint8_t icon) {
+	if (ui->quadCount == ui->quadCapacity && !reserveQuads(ui, ui->quadCapacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return;
+	}
+
+	uint32_t i = ui->quadCount++;
+	ui->x[i] = x;
+	ui->y[i] = y;
+	ui->h[i] = h;
+	ui->w[i] = w;
+	ui->color[i] = color;
+	ui->icon[i] = icon;
+}
+
+static void addLabel(eng_UI *ui, const char *text, float x, float y, uint32_t color) {
+	uint32_t length = (uint32_t)strlen(text) + 1;
+	if (ui->textLength + length > ui->textCapacity) {
+		uint32_t capacity = SDL_max(ui->textCapacity * 2, ui->textLength + length);
+		if (!growArray((void **)&ui->text, capacity, sizeof(char))) {
+			eng_setError(FAILED_TO_MALLOC);
+			return;
+		}
+		ui->textCapacity = capacity;
+	}
+
+	if (ui->labelCount == ui->labelCapacity && !reserveLabels(ui, ui->labelCapacity * 2)) {
+		eng_setError(FAILED_TO_MALLOC);
+		return;
+	}
+
+	uint32_t i = ui->labelCount++;
+	ui->labelX[i] = x;
+	ui->labelY[i] = y;
+	ui->labelColor[i] = color;
+	ui->textStart[i] = ui->textLength;
+	ui->labelQuad[i] = ui->quadCount;
+	memcpy(&ui->text[ui->textLength], text, length);
+	ui->textLength += length;
+}
+
+static bool isHovered(eng_UI *ui, float x, float y, float h, float w) {
+	return ui->mouseX >= x && ui->mouseX < x + w && ui->mouseY >= y && ui->mouseY < y + h;
+}
+
+// Handles the mouse for a clickable widget, returns true when it's released over the widget it was pressed on
+static bool updateClick(eng_UI *ui, uint32_t widget, float x, float y, float h, float w) {
+	bool hovered = isHovered(ui, x, y, h, w);
+	if (ui->mousePressed && ui->pressX >= x && ui->pressX < x + w && ui->pressY >= y && ui->pressY < y + h) {
+		ui->active = widget;
+	}
+
+	return ui->mouseReleased && ui->active == widget && hovered;
+}
+
+void eng_uiPanel(eng_UI *ui, float x, float y, float h, float w, uint32_t color) {
+	addQuad(ui, x, y, h, w, color, ENG_UI_NO_ICON);
+}
+
+void eng_uiLabel(eng_UI *ui, const char *text, float x, float y, uint32_t color) {
+	if (text == NULL) {
+		return;
+	}
+
+	addLabel(ui, text, x, y, color);
+}
+
+bool eng_uiButton(eng_UI *ui, const char *text, float x, float y, float h, float w) {
+	uint32_t widget = ui->widget++;
+	bool hovered = isHovered(ui, x, y, h, w);
+	bool clicked = updateClick(ui, widget, x, y, h, w);
+
+	uint32_t color = UI_BUTTON_COLOR;
+	if (hovered && ui->active == widget && ui->mouseDown) {
+		color = UI_PRESSED_COLOR;
+	} else if (hovered) {
+		color = UI_HOVER_COLOR;
+	}
+	addQuad(ui, x, y, h, w, color, ENG_UI_NO_ICON);
+
+	if (text != NULL) {
+		float textW = (float)strlen(text) * ENG_UI_TEXT_SIZE;
+		addLabel(ui, text, x + (w - textW) / 2, y + (h - ENG_UI_TEXT_SIZE) / 2, UI_TEXT_COLOR);
+	}
+
+	return clicked;
+}
+
+bool eng_uiIconButton(eng_UI *ui, ENG_UI_ICON icon, float x, float y, float scale) {
+	uint32_t widget = ui->widget++;
+	if (icon >= ENG_UI_ICON_COUNT || ui->iconW[icon] == 0) {
+		return false;
+	}
+
+	float h = ui->iconH[icon] * scale;
+	float w = ui->iconW[icon] * scale;
+	bool hovered = isHovered(ui, x, y, h, w);
+	bool clicked = updateClick(ui, widget, x, y, h, w);
+
+	uint32_t tint = 0xFFFFFFFF;
+	if (hovered && ui->active == widget && ui->mouseDown) {
+		tint = UI_ICON_PRESSED_TINT;
+	} else if (hovered) {
+		tint = UI_ICON_HOVER_TINT;
+	}
+	addQuad(ui, x, y, h, w, tint, (uint8_t)icon);
+
+	return clicked;
+}
+
+bool eng_uiSlider(eng_UI *ui, float *value, float min, float max, float x, float y, float h, float w) {
+	uint32_t widget = ui->widget++;
+	bool hovered = isHovered(ui, x, y, h, w);
+	updateClick(ui, widget, x, y, h, w);
+
+	bool changed = false;
+	if (ui->active == widget && ui->mouseDown && w > 0) {
+		float t = SDL_clamp((ui->mouseX - x) / w, 0.0f, 1.0f);
+		float newValue = min + t * (max - min);
+		changed = newValue != *value;
+		*value = newValue;
+	}
+
+	float t = max != min ? SDL_clamp((*value - min) / (max - min), 0.0f, 1.0f) : 0.0f;
+	float trackH = h / 3;
+	float knobW = h / 2;
+	addQuad(ui, x, y + trackH, trackH, w, UI_TRACK_COLOR, ENG_UI_NO_ICON);
+	addQuad(ui, x, y + trackH, trackH, w * t, UI_FILL_COLOR, ENG_UI_NO_ICON);
+	addQuad(ui, x + w * t - knobW / 2, y, h, knobW, hovered || ui->active == widget ? 0xFFFFFFFF : UI_KNOB_COLOR, ENG_UI_NO_ICON);
+
+	return changed;
+}
+
+bool eng_uiList(eng_UI *ui, const char **items, uint32_t count, int *selected, float x, float y, float rowH, float w) {
+	uint32_t widget = ui->widget++;
+	bool hovered = isHovered(ui, x, y, rowH * count, w);
+	bool clicked = updateClick(ui, widget, x, y, rowH * count, w);
+	int hoveredRow = hovered ? (int)((ui->mouseY - y) / rowH) : -1;
+
+	addQuad(ui, x, y, rowH * count, w, UI_LIST_COLOR, ENG_UI_NO_ICON);
+	for (uint32_t i = 0; i < count; i++) {
+		float rowY = y + rowH * i;
+		if ((int)i == *selected) {
+			addQuad(ui, x, rowY, rowH, w, UI_SELECTED_COLOR, ENG_UI_NO_ICON);
+		} else if ((int)i == hoveredRow) {
+			addQuad(ui, x, rowY, rowH, w, UI_HOVER_COLOR, ENG_UI_NO_ICON);
+		}
+
+		if (items[i] != NULL) {
+			addLabel(ui, items[i], x + ENG_UI_TEXT_SIZE / 2, rowY + (rowH - ENG_UI_TEXT_SIZE) / 2, UI_TEXT_COLOR);
+		}
+	}
+
+	if (clicked && hoveredRow >= 0 && hoveredRow < (int)count && hoveredRow != *selected) {
+		*selected = hoveredRow;
+		return true;
+	}
+
+	return false;
+}
+
+static uint64_t hashWords(uint64_t hash, const uint32_t *words, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		hash = (hash ^ words[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+static uint64_t hashBytes(uint64_t hash, const uint8_t *bytes, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+// Labels are drawn straight from this frame's arrays, only where they sit is hashed because it decides where ranges break
+static uint64_t hashFrame(eng_UI *ui) {
+	uint64_t hash = FNV_OFFSET;
+	hash = hashWords(hash, &ui->quadCount, 1);
+	hash = hashWords(hash, (const uint32_t *)ui->x, ui->quadCount);
+	hash = hashWords(hash, (const uint32_t *)ui->y, ui->quadCount);
+	hash = hashWords(hash, (const uint32_t *)ui->h, ui->quadCount);
+	hash = hashWords(hash, (const uint32_t *)ui->w, ui->quadCount);
+	hash = hashWords(hash, ui->color, ui->quadCount);
+	hash = hashBytes(hash, ui->icon, ui->quadCount);
+	hash = hashWords(hash, &ui->labelCount, 1);
+	hash = hashWords(hash, &ui->textLength, 1);
+	hash = hashWords(hash, (const uint32_t *)ui->labelX, ui->labelCount);
+	hash = hashWords(hash, (const uint32_t *)ui->labelY, ui->labelCount);
+	hash = hashWords(hash, ui->textStart, ui->labelCount);
+	hash = hashWords(hash, ui->labelQuad, ui->labelCount);
+
+	return hash;
+}
+
+static SDL_FColor unpackFColor(uint32_t color) {
+	return (SDL_FColor) {
+		.r = (float)(color >> 24) / 255.0f,
+		.g = (float)((color >> 16) & 0xFF) / 255.0f,
+		.b = (float)((color >> 8) & 0xFF) / 255.0f,
+		.a = (float)(color & 0xFF) / 255.0f,
+	};
+}
+
+static float getLabelWidth(eng_UI *ui, uint32_t label) {
+	uint32_t end = label + 1 < ui->labelCount ? ui->textStart[label + 1] : ui->textLength;
+
+	return (float)(end - ui->textStart[label] - 1) * ENG_UI_TEXT_SIZE;
+}
+
+static bool rebuildVertices(eng_UI *ui) {
+	if (!reserveVertices(ui, ui->quadCount)) {
+		eng_setError(FAILED_TO_MALLOC);
+		ui->rangeTotal = 0;
+		return false;
+	}
+
+	// Labels declared inside the current range are drawn after it, so the range has to end before a quad that would cover one of them
+	ui->rangeTotal = 0;
+	uint32_t label = 0;
+	float labelLeft = 0;
+	float labelTop = 0;
+	float labelRight = 0;
+	float labelBottom = 0;
+	bool hasLabels = false;
+	for (uint32_t i = 0; i < ui->quadCount; i++) {
+		float left = ui->x[i];
+		float top = ui->y[i];
+		float right = left + ui->w[i];
+		float bottom = top + ui->h[i];
+
+		bool coversLabel = hasLabels && left < labelRight && right > labelLeft && top < labelBottom && bottom > labelTop;
+		if (ui->rangeTotal == 0 || ui->icon[i] != ui->rangeIcon[ui->rangeTotal - 1] || coversLabel) {
+			ui->rangeStart[ui->rangeTotal] = i;
+			ui->rangeCount[ui->rangeTotal] = 0;
+			ui->rangeIcon[ui->rangeTotal] = ui->icon[i];
+			ui->rangeTotal++;
+			hasLabels = false;
+
+			// Labels declared before the range are drawn before it
+			while (label < ui->labelCount && ui->labelQuad[label] <= i) {
+				label++;
+			}
+		}
+		ui->rangeCount[ui->rangeTotal - 1]++;
+
+		// Labels declared right after this quad land inside the range
+		while (label < ui->labelCount && ui->labelQuad[label] <= i + 1) {
+			float labelX = ui->labelX[label];
+			float labelY = ui->labelY[label];
+			float labelW = getLabelWidth(ui, label);
+			labelLeft = hasLabels ? SDL_min(labelLeft, labelX) : labelX;
+			labelTop = hasLabels ? SDL_min(labelTop, labelY) : labelY;
+			labelRight = hasLabels ? SDL_max(labelRight, labelX + labelW) : labelX + labelW;
+			labelBottom = hasLabels ? SDL_max(labelBottom, labelY + ENG_UI_TEXT_SIZE) : labelY + ENG_UI_TEXT_SIZE;
+			hasLabels = true;
+			label++;
+		}
+
+		float *vertex = &ui->vertices[i * 8];
+		vertex[0] = left;
+		vertex[1] = top;
+		vertex[2] = right;
+		vertex[3] = top;
+		vertex[4] = right;
+		vertex[5] = bottom;
+		vertex[6] = left;
+		vertex[7] = bottom;
+
+		float *uv = &ui->uvs[i * 8];
+		uv[0] = 0;
+		uv[1] = 0;
+		uv[2] = 1;
+		uv[3] = 0;
+		uv[4] = 1;
+		uv[5] = 1;
+		uv[6] = 0;
+		uv[7] = 1;
+
+		SDL_FColor color = unpackFColor(ui->color[i]);
+		SDL_FColor *vertexColor = &ui->vertexColors[i * 4];
+		vertexColor[0] = color;
+		vertexColor[1] = color;
+		vertexColor[2] = color;
+		vertexColor[3] = color;
+	}
+
+	ui->rebuilds++;
+
+	return true;
+}
+
+void eng_endUI(eng_UI *ui) {
+	if (ui == NULL) {
+		eng_setError(DATA_IS_NULL);
+		return;
+	}
+
+	if (!ui->mouseDown) {
+		ui->active = UI_NO_WIDGET;
+	}
+
+	uint64_t hash = hashFrame(ui);
+	if (hash == ui->hash && ui->rebuilds > 0) {
+		ui->reused++;
+		return;
+	}
+
+	// A failed rebuild keeps the old hash so the next frame tries again
+	if (rebuildVertices(ui)) {
+		ui->hash = hash;
+	}
+}
+
+static void renderRange(SDL_Renderer *renderer, eng_UI *ui, uint32_t range) {
+	uint8_t icon = ui->rangeIcon[range];
+	SDL_Texture *texture = icon == ENG_UI_NO_ICON ? NULL : ui->icons[icon];
+	if (icon != ENG_UI_NO_ICON && texture == NULL) {
+		return;
+	}
+
+	uint32_t start = ui->rangeStart[range];
+	uint32_t count = ui->rangeCount[range];
+	SDL_RenderGeometryRaw(renderer, texture, &ui->vertices[start * 8], 2 * sizeof(float), &ui->vertexColors[start * 4], sizeof(SDL_FColor),
+		texture != NULL ? &ui->uvs[start * 8] : NULL, texture != NULL ? 2 * sizeof(float) : 0, count * 4, ui->indices, count * 6, sizeof(int));
+	eng_countDrawCalls(1, 1);
+}
+
+static void renderLabel(SDL_Renderer *renderer, eng_UI *ui, uint32_t label) {
+	uint32_t color = ui->labelColor[label];
+	SDL_SetRenderDrawColor(renderer, color >> 24, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+	SDL_RenderDebugText(renderer, ui->labelX[label], ui->labelY[label], &ui->text[ui->textStart[label]]);
+}
+
+void eng_renderUI(SDL_Renderer *renderer, eng_UI *ui) {
+	SDL_BlendMode previousBlendMode;
+	SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+	// Each label goes in before the first range that starts after it was declared
+	uint32_t label = 0;
+	for (uint32_t range = 0; range < ui->rangeTotal; range++) {
+		while (label < ui->labelCount && ui->labelQuad[label] <= ui->rangeStart[range]) {
+			renderLabel(renderer, ui, label++);
+		}
+		renderRange(renderer, ui, range);
+	}
+	while (label < ui->labelCount) {
+		renderLabel(renderer, ui, label++);
+	}
+	if (ui->labelCount > 0) {
+		eng_countDrawCalls(ui->labelCount, 0);
+	}
+
+	SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+}
+
+void eng_destroyUI(eng_UI *ui) {
+	if (ui == NULL) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < ENG_UI_ICON_COUNT; i++) {
+		eng_destroyTexture(ui->icons[i]);
+	}
+
+	free(ui->x);
+	free(ui->y);
+	free(ui->h);
+	free(ui->w);
+	free(ui->color);
+	free(ui->icon);
+	free(ui->labelX);
+	free(ui->labelY);
+	free(ui->labelColor);
+	free(ui->textStart);
+	free(ui->labelQuad);
+	free(ui->text);
+	free(ui->vertices);
+	free(ui->uvs);
+	free(ui->vertexColors);
+	free(ui->indices);
+	free(ui->rangeStart);
+	free(ui->rangeCount);
+	free(ui->rangeIcon);
+	free(ui);
+}
@@ -0,0 +1,154 @@
+#ifndef UI_H
+#define UI_H
+
+#include "engine.h"
+
+/*
+* Immediate mode widgets for menus and settings screens.
+*
+* Every frame the game passes each polled event to eng_uiHandleEvent, then calls eng_beginUI, one function per widget and eng_endUI.
+* Widget functions draw nothing themselves, they handle the mouse straight away and return what happened, so there's no widget state to
+* keep in sync with the game. The mouse comes from the events rather than SDL's live state, so a click pressed and released within one
+* frame isn't lost and replays and simulations can drive the widgets. Widgets are told apart by the order they're declared in, keep the
+* order the same from frame to frame while a slider is being dragged.
+*
+* What the widgets look like is kept as a list of quads and labels. eng_endUI hashes the list and only rebuilds the vertices when the hash
+* differs from the last frame, so a screen nobody is touching costs one hash. Add the UI to a render queue with TYPE_UI, everything is
+* drawn in the order it was declared so a panel covers the widgets before it. Neighbouring quads with the same art are drawn with one call,
+* a new call only starts when the art changes or a quad would cover a label declared before it.
+*/
+
+#define ENG_UI_NO_ICON 0xFF
+#define ENG_UI_TEXT_SIZE 8 // Labels use SDL's built in 8x8 font
+
+typedef enum {
+	ENG_UI_ICON_ACHIEVEMENTS,
+	ENG_UI_ICON_BACK,
+	ENG_UI_ICON_CLOSE,
+	ENG_UI_ICON_LEADERBOARD,
+	ENG_UI_ICON_LEVELS,
+	ENG_UI_ICON_NEXT,
+	ENG_UI_ICON_PLAY,
+	ENG_UI_ICON_PREVIOUS,
+	ENG_UI_ICON_RESTART,
+	ENG_UI_ICON_SETTINGS,
+	ENG_UI_ICON_VOLUME,
+	ENG_UI_ICON_COUNT,
+} ENG_UI_ICON;
+
+typedef struct {
+	// Button art from images/Menu/Buttons, missing images are left NULL
+	SDL_Texture *icons[ENG_UI_ICON_COUNT];
+	float iconH[ENG_UI_ICON_COUNT];
+	float iconW[ENG_UI_ICON_COUNT];
+
+	// Mouse for the frame being built
+	float mouseX;
+	float mouseY;
+	float pressX; // Where the last press happened
+	float pressY;
+	bool mouseDown;
+	bool mousePressed;
+	bool mouseReleased;
+
+	// Mouse events since the last eng_beginUI
+	bool pendingPress;
+	bool pendingRelease;
+	uint32_t widget;
+	uint32_t active; // Widget the mouse was pressed on or UINT32_MAX
+
+	// Quads declared this frame, icon is ENG_UI_NO_ICON for solid rects
+	float *x;
+	float *y;
+	float *h;
+	float *w;
+	uint32_t *color;
+	uint8_t *icon;
+	uint32_t quadCount;
+	uint32_t quadCapacity;
+
+	// Labels declared this frame, textStart indexes into text where each label is stored with its terminator
+	float *labelX;
+	float *labelY;
+	uint32_t *labelColor;
+	uint32_t *textStart;
+	uint32_t *labelQuad; // How many quads were declared before the label, it's drawn over them and under the rest
+	uint32_t labelCount;
+	uint32_t labelCapacity;
+	char *text;
+	uint32_t textLength;
+	uint32_t textCapacity;
+
+	// Vertices built by the last rebuild in declaration order, each range is a run of quads drawn with one call
+	float *vertices;
+	float *uvs;
+	SDL_FColor *vertexColors;
+	int *indices;
+	uint32_t vertexCapacity;
+	uint32_t indexCapacity;
+	uint32_t *rangeStart;
+	uint32_t *rangeCount;
+	uint8_t *rangeIcon; // ENG_UI_NO_ICON for solid rects
+	uint32_t rangeTotal;
+	uint32_t rangeCapacity;
+
+	uint64_t hash;
+	uint32_t rebuilds;
+	uint32_t reused;
+} eng_UI;
+
+/*
+* Loads the button art from buttonDirectory, pass NULL to only use text widgets. Without a renderer only the art's sizes are read
+*/
+eng_UI *eng_createUI(Window *window, const char *buttonDirectory);
+
+/*
+* Feeds an event from eng_pollEvent to the widgets, call it for every event before eng_beginUI
+*/
+void eng_uiHandleEvent(eng_UI *ui, Application *app);
+
+/*
+* Starts a frame of widgets with the mouse events handled since the last frame
+*/
+void eng_beginUI(eng_UI *ui);
+
+/*
+* Finishes the frame, the vertices are only rebuilt if something looks different from the last frame
+*/
+void eng_endUI(eng_UI *ui);
+
+/*
+* A solid rect, use it behind other widgets
+*/
+void eng_uiPanel(eng_UI *ui, float x, float y, float h, float w, uint32_t color);
+
+void eng_uiLabel(eng_UI *ui, const char *text, float x, float y, uint32_t color);
+
+/*
+* A rect with centered text, returns true on the frame it's clicked
+*/
+bool eng_uiButton(eng_UI *ui, const char *text, float x, float y, float h, float w);
+
+/*
+* A button drawn with its art at scale, returns true on the frame it's clicked
+*/
+bool eng_uiIconButton(eng_UI *ui, ENG_UI_ICON icon, float x, float y, float scale);
+
+/*
+* A horizontal slider between min and max, returns true when the value was changed by dragging
+*/
+bool eng_uiSlider(eng_UI *ui, float *value, float min, float max, float x, float y, float h, float w);
+
+/*
+* A column of rows, one per item. Returns true when a row is clicked and sets selected to it, selected can be -1 for none
+*/
+bool eng_uiList(eng_UI *ui, const char **items, uint32_t count, int *selected, float x, float y, float rowH, float w);
+
+/*
+* Draws the last built frame, this is called by the render queue for TYPE_UI
+*/
+void eng_renderUI(SDL_Renderer *renderer, eng_UI *ui);
+
+void eng_destroyUI(eng_UI *ui);
+
+#endif